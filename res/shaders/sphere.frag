@@ -0,0 +1,30 @@
+#version 410 core
+
+in vec3 vColor;
+in vec3 vCenter;
+in vec3 vPoint;
+in float vRadius;
+out vec4 FragColor;
+
+uniform mat4 u_Projection;
+
+void main()
+{
+    // Eye ray (from the view-space origin) against the sphere; misses are outside the silhouette
+    vec3 dir = normalize(vPoint);
+    float b = dot(dir, vCenter);
+    float h = b * b - dot(vCenter, vCenter) + vRadius * vRadius;
+    if (h < 0.0) discard;
+    vec3 hit = dir * (b - sqrt(h));
+    vec3 normal = (hit - vCenter) / vRadius;
+
+    // Depth of the actual surface, so spheres intersect correctly with each other and the bonds
+    vec4 clip = u_Projection * vec4(hit, 1.0);
+    gl_FragDepth = 0.5 * clip.z / clip.w + 0.5;
+
+    // Key light from the upper right of the camera, ambient, and a small highlight
+    vec3 light = normalize(vec3(0.4, 0.8, 0.6));
+    float diffuse = max(dot(normal, light), 0.0);
+    float specular = pow(max(dot(reflect(-light, normal), -dir), 0.0), 32.0);
+    FragColor = vec4(vColor * (0.25 + 0.75 * diffuse) + vec3(0.25 * specular), 1.0);
+}
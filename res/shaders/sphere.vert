@@ -0,0 +1,28 @@
+#version 410 core
+
+// One instance per agent: a camera-facing quad in front of the sphere, ray-traced in sphere.frag
+layout (location = 0) in vec4 aSphere;  // Centre (xyz) and radius (w)
+layout (location = 1) in vec3 aColor;
+
+out vec3 vColor;
+out vec3 vCenter;   // View space
+out vec3 vPoint;    // View-space point on the quad; the eye ray of this fragment passes through it
+out float vRadius;
+
+uniform mat4 u_View;
+uniform mat4 u_Projection;
+uniform float u_RadiusScale;    // Level of detail: sampled agents stand in for their neighbours
+
+void main()
+{
+    // Triangle strip corners (-1,-1) (1,-1) (-1,1) (1,1)
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+
+    vRadius = aSphere.w * u_RadiusScale;
+    vCenter = (u_View * vec4(aSphere.xyz, 1.0)).xyz;
+    // Slightly oversized so the silhouette stays covered under perspective
+    vPoint = vCenter + vec3(corner * vRadius * 1.5, vRadius);
+    vColor = aColor;
+
+    gl_Position = u_Projection * vec4(vPoint, 1.0);
+}
@@ -0,0 +1,226 @@
+#include "GlutenSim.h"
+#include "Simulation/SimulationEngine.h"
+#include <cstring>
+
+static_assert(sizeof(AgentType) == sizeof(uint8_t), "gs_agent_types is documented as uint8_t");
+static_assert(sizeof(int) == sizeof(int32_t), "gs_agent_ids is documented as int32_t");
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "gs_agent_positions is documented as float[3]");
+static_assert(offsetof(Spring, b) == offsetof(Spring, a) + sizeof(Agent*), "gs_bond_agents reads two adjacent references");
+static_assert(GS_GLUTENIN == (int)GLUTENIN && GS_GLIADIN == (int)GLIADIN && GS_STARCH == (int)STARCH, "GS_* must match AgentType");
+
+namespace {
+    const char* const PARAMETER_NAMES[] = {
+        "temperature", "bond_probability", "rising_rate", "max_spring_length", "min_spring_length",
+        "collision_radius", "repulsion_k", "static_friction", "dynamic_friction",
+        "spring_k", "bond_distance", "breaking_threshold", "damping",
+        "central_force_k", "mixer_speed", "mixer_spin", "gravity_mode", "mixer_tool",
+        "shear_rate", "periodic", "box_cells", "contact_law", "adhesion", "adhesion_range",
+    };
+
+    template<typename T>
+    GsView MakeView(const T* first, size_t count, size_t stride) {
+        return { count > 0 ? first : nullptr, count, stride };
+    }
+}
+
+// The opaque handle behind the C API; friend of SimulationEngine like Application
+struct GsSimulation {
+    SimulationEngine engine;
+    // The box layout is fixed between inits: these wait for the next gs_init
+    bool periodic = engine.m_Periodic;
+    int boxCells = engine.m_BoxCells;
+
+    void Init(int agentCount) {
+        engine.m_Periodic = periodic;
+        engine.m_BoxCells = boxCells;
+        engine.Init(agentCount);
+    }
+
+    float* FloatParameter(const char* name) {
+        SimulationEngine& e = engine;
+        if (!std::strcmp(name, "temperature")) return &e.m_Temperature;
+        if (!std::strcmp(name, "bond_probability")) return &e.m_BondProbability;
+        if (!std::strcmp(name, "rising_rate")) return &e.m_SpringExpansionRate;
+        if (!std::strcmp(name, "max_spring_length")) return &e.m_MaxSpringLength;
+        if (!std::strcmp(name, "min_spring_length")) return &e.m_MinSpringLength;
+        if (!std::strcmp(name, "collision_radius")) return &e.m_CollisionRadius;
+        if (!std::strcmp(name, "repulsion_k")) return &e.m_RepulsionK;
+        if (!std::strcmp(name, "static_friction")) return &e.m_StaticFriction;
+        if (!std::strcmp(name, "dynamic_friction")) return &e.m_DynamicFriction;
+        if (!std::strcmp(name, "spring_k")) return &e.m_SpringK;
+        if (!std::strcmp(name, "bond_distance")) return &e.m_BondDistance;
+        if (!std::strcmp(name, "breaking_threshold")) return &e.m_BreakingThreshold;
+        if (!std::strcmp(name, "damping")) return &e.m_Damping;
+        if (!std::strcmp(name, "central_force_k")) return &e.m_CentralForceK;
+        if (!std::strcmp(name, "mixer_speed")) return &e.m_Mixer.speed;
+        if (!std::strcmp(name, "mixer_spin")) return &e.m_Mixer.spin;
+        if (!std::strcmp(name, "shear_rate")) return &e.m_ShearRate;
+        if (!std::strcmp(name, "adhesion")) return &e.m_Adhesion;
+        if (!std::strcmp(name, "adhesion_range")) return &e.m_AdhesionRange;
+        return nullptr;
+    }
+
+    int Set(const char* name, float value) {
+        if (float* field = FloatParameter(name)) {
+            *field = value;
+            return GS_OK;
+        }
+        if (!std::strcmp(name, "gravity_mode")) {
+            int mode = (int)value;
+            if (mode < SimulationEngine::NONE || mode > SimulationEngine::CENTRAL) return GS_ERROR;
+            engine.m_GravityMode = (SimulationEngine::GravityMode)mode;
+            return GS_OK;
+        }
+        if (!std::strcmp(name, "mixer_tool")) {
+            int tool = (int)value;
+            if (tool < SimulationEngine::ROD || tool > SimulationEngine::DOUGH_HOOK) return GS_ERROR;
+            engine.m_MixerTool = (SimulationEngine::MixerTool)tool;
+            engine.RebuildColliders();
+            return GS_OK;
+        }
+        if (!std::strcmp(name, "periodic")) {
+            periodic = value != 0.0f;
+            return GS_OK;
+        }
+        if (!std::strcmp(name, "box_cells")) {
+            if (value < 3.0f) return GS_ERROR;
+            boxCells = (int)value;
+            return GS_OK;
+        }
+        if (!std::strcmp(name, "contact_law")) {
+            int law = (int)value;
+            if (law < ContactTable::LINEAR || law > ContactTable::HERTZ) return GS_ERROR;
+            engine.m_ContactLaw = (ContactTable::Law)law;
+            return GS_OK;
+        }
+        return GS_UNKNOWN_PARAMETER;
+    }
+
+    int Get(const char* name, float* value) {
+        if (float* field = FloatParameter(name)) *value = *field;
+        else if (!std::strcmp(name, "gravity_mode")) *value = (float)engine.m_GravityMode;
+        else if (!std::strcmp(name, "mixer_tool")) *value = (float)engine.m_MixerTool;
+        else if (!std::strcmp(name, "periodic")) *value = periodic ? 1.0f : 0.0f;
+        else if (!std::strcmp(name, "box_cells")) *value = (float)boxCells;
+        else if (!std::strcmp(name, "contact_law")) *value = (float)engine.m_ContactLaw;
+        else return GS_UNKNOWN_PARAMETER;
+        return GS_OK;
+    }
+
+    GsView Agents() const {
+        const auto& agents = engine.m_Agents;
+        return MakeView(agents.data(), agents.size(), sizeof(Agent));
+    }
+    GsView Positions() const {
+        const auto& agents = engine.m_Agents;
+        return MakeView(agents.empty() ? nullptr : &agents[0].position, agents.size(), sizeof(Agent));
+    }
+    GsView Types() const {
+        const auto& agents = engine.m_Agents;
+        return MakeView(agents.empty() ? nullptr : &agents[0].type, agents.size(), sizeof(Agent));
+    }
+    GsView Ids() const {
+        const auto& agents = engine.m_Agents;
+        return MakeView(agents.empty() ? nullptr : &agents[0].id, agents.size(), sizeof(Agent));
+    }
+    GsView BondAgents() const {
+        const auto& springs = engine.m_Springs;
+        return MakeView(springs.empty() ? nullptr : &springs[0].a, springs.size(), sizeof(Spring));
+    }
+    GsView BondRestLengths() const {
+        const auto& springs = engine.m_Springs;
+        return MakeView(springs.empty() ? nullptr : &springs[0].restLength, springs.size(), sizeof(Spring));
+    }
+    float Time() const { return engine.m_Time; }
+    int BrokenBonds() const { return engine.m_BrokenBondsTotal; }
+    float YoungsModulus() const { return engine.GetYoungsModulus(); }
+    float ShearStress() const { return engine.m_ShearStress; }
+};
+
+// No exception may cross the C boundary (undefined behaviour for C callers): every entry point runs
+// its body through Guard, which turns any exception into the function's failure value
+namespace {
+    template<typename Result, typename Body>
+    Result Guard(Result failure, Body body) noexcept {
+        try {
+            return body();
+        } catch (...) {
+            return failure;
+        }
+    }
+
+    template<typename Body>
+    void Guard(Body body) noexcept {
+        try {
+            body();
+        } catch (...) {
+        }
+    }
+}
+
+int gs_api_version(void) {
+    return GS_API_VERSION;
+}
+
+GsSimulation* gs_create(void) {
+    // The engine allocates in its constructor too, so nothrow new alone would not cover it
+    return Guard((GsSimulation*)nullptr, [] { return new GsSimulation(); });
+}
+
+int gs_init(GsSimulation* sim, int agentCount) {
+    if (!sim || agentCount <= 0) return GS_ERROR;
+    return Guard((int)GS_ERROR, [&] {
+        sim->Init(agentCount);
+        return (int)GS_OK;
+    });
+}
+
+int gs_step(GsSimulation* sim, float dt, int steps) {
+    if (!sim || dt <= 0.0f || steps < 0) return GS_ERROR;
+    return Guard((int)GS_ERROR, [&] {
+        for (int i = 0; i < steps; ++i) sim->engine.Update(dt);
+        return (int)GS_OK;
+    });
+}
+
+void gs_destroy(GsSimulation* sim) {
+    Guard([&] { delete sim; });
+}
+
+int gs_set_parameter(GsSimulation* sim, const char* name, float value) {
+    if (!sim || !name) return GS_ERROR;
+    return Guard((int)GS_ERROR, [&] { return sim->Set(name, value); });
+}
+
+int gs_get_parameter(const GsSimulation* sim, const char* name, float* value) {
+    if (!sim || !name || !value) return GS_ERROR;
+    return Guard((int)GS_ERROR, [&] { return const_cast<GsSimulation*>(sim)->Get(name, value); });
+}
+
+const char* gs_parameter_name(int index) {
+    int count = (int)(sizeof(PARAMETER_NAMES) / sizeof(PARAMETER_NAMES[0]));
+    return index >= 0 && index < count ? PARAMETER_NAMES[index] : nullptr;
+}
+
+GsView gs_agents(const GsSimulation* sim) { return Guard(GsView{}, [&] { return sim ? sim->Agents() : GsView{}; }); }
+GsView gs_agent_positions(const GsSimulation* sim) { return Guard(GsView{}, [&] { return sim ? sim->Positions() : GsView{}; }); }
+GsView gs_agent_types(const GsSimulation* sim) { return Guard(GsView{}, [&] { return sim ? sim->Types() : GsView{}; }); }
+GsView gs_agent_ids(const GsSimulation* sim) { return Guard(GsView{}, [&] { return sim ? sim->Ids() : GsView{}; }); }
+GsView gs_bond_agents(const GsSimulation* sim) { return Guard(GsView{}, [&] { return sim ? sim->BondAgents() : GsView{}; }); }
+GsView gs_bond_rest_lengths(const GsSimulation* sim) { return Guard(GsView{}, [&] { return sim ? sim->BondRestLengths() : GsView{}; }); }
+
+float gs_time(const GsSimulation* sim) { return Guard(0.0f, [&] { return sim ? sim->Time() : 0.0f; }); }
+int gs_broken_bonds(const GsSimulation* sim) { return Guard(0, [&] { return sim ? sim->BrokenBonds() : 0; }); }
+float gs_youngs_modulus(const GsSimulation* sim) { return Guard(0.0f, [&] { return sim ? sim->YoungsModulus() : 0.0f; }); }
+float gs_shear_stress(const GsSimulation* sim) { return Guard(0.0f, [&] { return sim ? sim->ShearStress() : 0.0f; }); }
+
+int gs_telemetry_open(GsSimulation* sim, const char* stream) {
+    if (!sim || !stream) return GS_ERROR;
+    return Guard((int)GS_ERROR, [&] { return sim->engine.OpenTelemetry(stream) ? (int)GS_OK : (int)GS_ERROR; });
+}
+
+void gs_telemetry_close(GsSimulation* sim) {
+    Guard([&] {
+        if (sim) sim->engine.CloseTelemetry();
+    });
+}
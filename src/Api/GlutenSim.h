@@ -0,0 +1,105 @@
+#pragma once
+/*
+ * C API of the simulation library (GlutenSim target), for analysis tools running it in-process.
+ *
+ * The functions below are the stable interface: new functions may be added, existing ones keep
+ * their signature and meaning. Check gs_api_version() against GS_API_VERSION when loading the
+ * shared library at runtime.
+ *
+ * Views are zero-copy: they point straight into the engine's arrays and stay valid only until the
+ * next gs_init / gs_step / gs_set_parameter / gs_destroy call on the same simulation.
+ * Elements are 'stride' bytes apart, so read element i at (const char*)view.data + i * view.stride.
+ * The engine re-sorts agents by position from time to time, so an index may name a different agent
+ * after gs_step; gs_agent_ids gives the stable identity.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(GLUTENSIM_SHARED)
+#  if defined(_WIN32)
+#    if defined(GLUTENSIM_BUILD)
+#      define GS_API __declspec(dllexport)
+#    else
+#      define GS_API __declspec(dllimport)
+#    endif
+#  else
+#    define GS_API __attribute__((visibility("default")))
+#  endif
+#else
+#  define GS_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GS_API_VERSION 1
+
+typedef struct GsSimulation GsSimulation;
+
+typedef struct GsView {
+    const void* data;   /* First element, NULL when count is 0 */
+    size_t count;
+    size_t stride;      /* Bytes between consecutive elements */
+} GsView;
+
+/* Agent types as stored in the gs_agent_types view (one uint8_t each) */
+enum { GS_GLUTENIN = 0, GS_GLIADIN = 1, GS_STARCH = 2 };
+
+/* Return codes */
+enum { GS_OK = 0, GS_ERROR = -1, GS_UNKNOWN_PARAMETER = -2 };
+
+GS_API int gs_api_version(void);
+
+/* Lifetime */
+GS_API GsSimulation* gs_create(void);
+GS_API int gs_init(GsSimulation* sim, int agentCount);        /* Spawns agentCount agents in the bowl */
+GS_API int gs_step(GsSimulation* sim, float dt, int steps);    /* Advances 'steps' fixed steps of dt seconds */
+GS_API void gs_destroy(GsSimulation* sim);
+
+/*
+ * Parameters by name, e.g. "temperature", "bond_probability", "repulsion_k", "gravity_mode"
+ * (0 none, 1 gravity, 2 central), "mixer_tool" (0 rod, 1 dough hook). "periodic" (1 = periodic
+ * box sheared at "shear_rate" instead of the bowl, "box_cells" grid cells per side) takes effect
+ * at the next gs_init (reading them back returns the value set). "contact_law" (0 linear, 1 Hertz) shapes the repulsion; "adhesion" (N) pulls
+ * starch towards whatever it touches within "adhesion_range" contact distances past contact.
+ * gs_parameter_name() enumerates all of them and returns NULL past the last one.
+ */
+GS_API int gs_set_parameter(GsSimulation* sim, const char* name, float value);
+GS_API int gs_get_parameter(const GsSimulation* sim, const char* name, float* value);
+GS_API const char* gs_parameter_name(int index);
+
+/* Agent state: opaque agent records, float[3] positions, uint8_t types, int32_t ids (same order) */
+GS_API GsView gs_agents(const GsSimulation* sim);
+GS_API GsView gs_agent_positions(const GsSimulation* sim);
+GS_API GsView gs_agent_types(const GsSimulation* sim);
+GS_API GsView gs_agent_ids(const GsSimulation* sim);
+
+/*
+ * Bonds: two agent references (const void*) per bond, and float rest lengths.
+ * A reference points at a record of the gs_agents view; gs_agent_index turns it into an index
+ * for the agent views.
+ */
+GS_API GsView gs_bond_agents(const GsSimulation* sim);
+GS_API GsView gs_bond_rest_lengths(const GsSimulation* sim);
+
+static inline size_t gs_agent_index(GsView agents, const void* ref) {
+    return (size_t)((const char*)ref - (const char*)agents.data) / agents.stride;
+}
+
+/* Analytics */
+GS_API float gs_time(const GsSimulation* sim);
+GS_API int gs_broken_bonds(const GsSimulation* sim);
+GS_API float gs_youngs_modulus(const GsSimulation* sim);
+GS_API float gs_shear_stress(const GsSimulation* sim);        /* Periodic box only, 0 otherwise */
+
+/*
+ * Telemetry: every step appends a record (bonds, broken bonds, modulus, phase timings, steps/s) to
+ * the shared-memory stream /glutensim-<stream>; watch it with the glutensim-telemetry tool.
+ */
+GS_API int gs_telemetry_open(GsSimulation* sim, const char* stream);
+GS_API void gs_telemetry_close(GsSimulation* sim);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,37 @@
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifndef NDEBUG
+
+namespace {
+    // Relaxed: only the total matters, not its order against other memory operations
+    std::atomic<size_t> s_Allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+bool AllocationTracker::IsEnabled() { return true; }
+size_t AllocationTracker::GetAllocationCount() { return s_Allocations.load(std::memory_order_relaxed); }
+
+#else
+
+bool AllocationTracker::IsEnabled() { return false; }
+size_t AllocationTracker::GetAllocationCount() { return 0; }
+
+#endif
@@ -0,0 +1,12 @@
+#pragma once
+#include <cstddef>
+
+// Counts calls to the global operator new in debug builds (NDEBUG not defined).
+// Release builds keep the default allocator and always report 0.
+// The count covers every thread, so the OpenMP team and the task pool of a step are included; so are
+// background jobs (rheometer, auto-tuner probes) while they run.
+namespace AllocationTracker {
+    bool IsEnabled();
+    // operator new calls made so far by the whole process
+    size_t GetAllocationCount();
+}
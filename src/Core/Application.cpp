@@ -1,7 +1,13 @@
 #include "Application.h"
+#include "AllocationTracker.h"
 #include "Renderer/Shader.h"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <thread>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -13,6 +19,9 @@
 
 Application::Application(int width, int height, const char* title) 
     : m_Width(width), m_Height(height), m_Title(title) {
+    long long started = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    std::snprintf(m_TelemetryStream, sizeof(m_TelemetryStream), "app-%lld", started);
+    std::snprintf(m_HistoryPath, sizeof(m_HistoryPath), "history-%s.gsts", m_TelemetryStream);
     Init();
 }
 
@@ -68,80 +77,59 @@ void Application::Init() {
     ImGui_ImplOpenGL3_Init("#version 450");
 
     // Simulation Init
-    m_SimEngine.Init(1000); // 1000 agents
+    m_SimEngine.Init(m_SpawnCount);
 
     std::cout << "OpenGL Init OK! Version: " << glGetString(GL_VERSION) << std::endl;
 }
 
 void Application::MainLoop() {
     Shader shader("res/shaders/basic.vert", "res/shaders/basic.frag");
+    Shader sphereShader("res/shaders/sphere.vert", "res/shaders/sphere.frag");
 
     float lastFrame = 0.0f;
 
-    // VBO for points (Simple rendering)
+    // Per-instance VBOs for the sphere impostors (the quad corners come from gl_VertexID)
+    // Vertex buffers start sized for 1000 agents and grow in UploadVertices when needed
     glGenVertexArrays(1, &m_AgentVAO);
     glGenBuffers(1, &m_AgentVBO);
     glBindVertexArray(m_AgentVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_AgentVBO);
-    glBufferData(GL_ARRAY_BUFFER, 1000 * 3 * sizeof(float), NULL, GL_DYNAMIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    UploadVertices(m_AgentVBO, m_AgentVBOBytes, NULL, 1000 * 4 * sizeof(float));
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
     
     // VBO for Colors
     glGenBuffers(1, &m_ColorVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_ColorVBO);
-    glBufferData(GL_ARRAY_BUFFER, 1000 * 3 * sizeof(float), NULL, GL_DYNAMIC_DRAW);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    UploadVertices(m_ColorVBO, m_ColorVBOBytes, NULL, 1000 * 4);
+    glVertexAttribPointer(1, 3, GL_UNSIGNED_BYTE, GL_TRUE, 4, (void*)0);
     glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
     
-    // VBO for Bonds (Lines)
+    // VBO for Bonds (Lines), all white so the color is a constant attribute
     glGenVertexArrays(1, &m_BondVAO);
     glGenBuffers(1, &m_BondVBO);
-    glGenBuffers(1, &m_BondColorVBO);
     glBindVertexArray(m_BondVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_BondVBO);
     // Estimate max bonds: 1000 agents * 4 bonds * 2 points * 3 floats
-    glBufferData(GL_ARRAY_BUFFER, 1000 * 8 * 3 * sizeof(float), NULL, GL_DYNAMIC_DRAW);
+    UploadVertices(m_BondVBO, m_BondVBOBytes, NULL, 1000 * 8 * 3 * sizeof(float));
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // VBO + VAO for the Container wireframe
+    glGenVertexArrays(1, &m_ContainerVAO);
+    glGenBuffers(1, &m_ContainerVBO);
+    glBindVertexArray(m_ContainerVAO);
+    UploadVertices(m_ContainerVBO, m_ContainerVBOBytes, NULL, 256 * 3 * sizeof(float));
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
-    
-    // Color for Bonds
-    glBindBuffer(GL_ARRAY_BUFFER, m_BondColorVBO);
-    glBufferData(GL_ARRAY_BUFFER, 1000 * 8 * 3 * sizeof(float), NULL, GL_DYNAMIC_DRAW);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(1);
 
-    // VBO + VAO for Mixer (Rod) --------------------
+    // VBO + VAO for Mixer Tool (outline segments, uploaded every frame)
     glGenVertexArrays(1, &m_RodVAO);
     glGenBuffers(1, &m_RodVBO);
     glBindVertexArray(m_RodVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_RodVBO);
-
-    // 2 vertices * 3 floats per vertex
-    glBufferData(GL_ARRAY_BUFFER, 2 * 3 * sizeof(float), NULL, GL_DYNAMIC_DRAW);
-
+    UploadVertices(m_RodVBO, m_RodVBOBytes, NULL, 64 * 3 * sizeof(float));
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
-    // Render Mixer as a vertical rod (line)
-    glm::vec3 mixer = m_SimEngine.m_Mixer.position;
-
-    // Two endpoints of the rod
-    float rodVertices[] = {
-        mixer.x, -1.0f, mixer.z,   // bottom point
-        mixer.x,  1.0f, mixer.z    // top point
-    };
-
-    glBindVertexArray(m_RodVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_RodVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(rodVertices), rodVertices);
-
-    shader.SetVec3("u_Color", glm::vec3(1.0f, 0.0f, 0.0f));
-    glDrawArrays(GL_LINES, 0, 2);
-
-    //-------------------------------------------------------
-
-
     while (!glfwWindowShouldClose(m_Window)) {
         float currentFrame = glfwGetTime();
         float deltaTime = currentFrame - lastFrame;
@@ -150,6 +138,9 @@ void Application::MainLoop() {
         // Prevent Death Spiral (Lag)
         if (deltaTime > 0.1f) deltaTime = 0.1f;
 
+        size_t allocationsAtStart = AllocationTracker::GetAllocationCount();
+        m_FrameArena.Reset();
+
         // Start UI Frame (Input Processing)
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -158,30 +149,30 @@ void Application::MainLoop() {
         // Render UI (This updates variables immediately based on user input)
         RenderUI();
 
+        // Auto-tuning is cheap per frame: probes run in the background, their result is applied here.
+        // Probes time the machine, so nothing else may step meanwhile: neither the rheometer nor the
+        // live simulation, which holds until they are done (the UI keeps drawing).
+        if (!m_Domain.IsRunning() && !m_RheometerJob.valid()) m_AutoTuner.Maintain(m_SimEngine, m_FixedStep);
+
         // Physics Update (Fixed Step)
         // Now uses the updated variables from this frame's UI
-        if (!m_IsPaused) {
+        if (!m_IsPaused && !m_AutoTuner.IsTuning()) {
             m_TimeAccumulator += deltaTime * m_TimeScale; // Apply Time Scale
             int steps = 0;
             while (m_TimeAccumulator >= m_FixedStep && steps < 5) { // Max 5 steps per frame
-                m_SimEngine.Update(m_FixedStep);
+                if (m_Domain.IsRunning()) m_Domain.Step(m_SimEngine, m_FixedStep);
+                else m_SimEngine.Update(m_FixedStep);
                 m_TimeAccumulator -= m_FixedStep;
                 steps++;
                 
                 // Collect Plot Data
                 static int plotCounter = 0;
                 if (++plotCounter % 10 == 0) {
-                    m_PlotTime.push_back(currentFrame);
-                    m_PlotBonds.push_back((float)m_SimEngine.m_Springs.size());
-                    m_PlotBroken.push_back((float)m_SimEngine.m_BrokenBondsTotal);
-                    m_PlotYoungs.push_back(m_SimEngine.GetYoungsModulus());
-                    
-                    if (m_PlotTime.size() > 1000) {
-                        m_PlotTime.erase(m_PlotTime.begin());
-                        m_PlotBonds.erase(m_PlotBonds.begin());
-                        m_PlotBroken.erase(m_PlotBroken.begin());
-                        m_PlotYoungs.erase(m_PlotYoungs.begin());
-                    }
+                    float sample[HISTORY_CHANNELS];
+                    sample[HISTORY_BONDS] = (float)m_SimEngine.m_Springs.size();
+                    sample[HISTORY_BROKEN] = (float)m_SimEngine.m_BrokenBondsTotal;
+                    sample[HISTORY_YOUNGS] = m_SimEngine.GetYoungsModulus();
+                    m_History.Append(currentFrame, sample);
                 }
             }
         }
@@ -201,168 +192,139 @@ void Application::MainLoop() {
                                          glm::vec3(0.0f, 1.0f, 0.0f));
             glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)m_Width / (float)m_Height, 0.1f, 100.0f);
             shader.SetMat4("u_ViewProjection", projection * view);
+
+            const auto& springs = m_SimEngine.m_Springs;
+            const auto& agents = m_SimEngine.GetAgents();
+            float footprint = ContainerFootprint(projection * view);
+            m_AgentStride = LodStride(agents.size(), footprint);
+            m_BondStride = LodStride(springs.size(), footprint);
+            // Knuth's multiplicative hash spreads consecutive IDs over the strides
+            auto sampled = [](unsigned int id, int stride) { return stride == 1 || (id * 2654435761u >> 8) % stride == 0; };
             
             // 1. Render Bonds (Lines)
             // We draw bonds FIRST so they are behind agents
-            const auto& springs = m_SimEngine.m_Springs;
+            // Staging arrays come from the frame arena: no heap traffic once it has warmed up
             if (!springs.empty()) {
-                static std::vector<float> bondPos;
-                static std::vector<float> bondColor;
-                bondPos.clear();
-                bondColor.clear();
-                bondPos.reserve(springs.size() * 2 * 3);
-                bondColor.reserve(springs.size() * 2 * 3);
-                
-                const float whiteColor[3] = {1.0f, 1.0f, 1.0f};
-                
+                float* bondPos = m_FrameArena.Allocate<float>(springs.size() * 2 * 3);
+                float* p = bondPos;
                 for (const auto& s : springs) {
-                    // Position data
-                    bondPos.push_back(s.a->position.x);
-                    bondPos.push_back(s.a->position.y);
-                    bondPos.push_back(s.a->position.z);
-                    
-                    bondPos.push_back(s.b->position.x);
-                    bondPos.push_back(s.b->position.y);
-                    bondPos.push_back(s.b->position.z);
-                    
-                    // Color data (white for both vertices)
-                    bondColor.insert(bondColor.end(), whiteColor, whiteColor + 3);
-                    bondColor.insert(bondColor.end(), whiteColor, whiteColor + 3);
+                    if (!sampled(s.a->id * 31u + s.b->id, m_BondStride)) continue;
+                    // In the periodic box a bond across a face is drawn to the nearest image of its far end
+                    glm::vec3 b = s.a->position + m_SimEngine.Separation(s.b->position, s.a->position);
+                    *p++ = s.a->position.x; *p++ = s.a->position.y; *p++ = s.a->position.z;
+                    *p++ = b.x; *p++ = b.y; *p++ = b.z;
                 }
+                size_t bondVertices = (p - bondPos) / 3;
                 
                 glBindVertexArray(m_BondVAO);
-                
-                glBindBuffer(GL_ARRAY_BUFFER, m_BondVBO);
-                glBufferSubData(GL_ARRAY_BUFFER, 0, bondPos.size() * sizeof(float), bondPos.data());
-                
-                glBindBuffer(GL_ARRAY_BUFFER, m_BondColorVBO);
-                glBufferSubData(GL_ARRAY_BUFFER, 0, bondColor.size() * sizeof(float), bondColor.data());
-                
-                glDrawArrays(GL_LINES, 0, bondPos.size() / 3);
+                UploadVertices(m_BondVBO, m_BondVBOBytes, bondPos, bondVertices * 3 * sizeof(float));
+                glVertexAttrib3f(1, 1.0f, 1.0f, 1.0f);
+                glDrawArrays(GL_LINES, 0, bondVertices);
             }
             
-            // 2. Render Agents
-            const auto& agents = m_SimEngine.GetAgents();
-            
-            static std::vector<float> gpuPos;
-            static std::vector<float> gpuColor;
-            gpuPos.clear();
-            gpuColor.clear();
-            gpuPos.reserve(agents.size() * 3);
-            gpuColor.reserve(agents.size() * 3);
-            
-            for (const auto& agent : agents) {
-                gpuPos.push_back(agent.position.x);
-                gpuPos.push_back(agent.position.y);
-                gpuPos.push_back(agent.position.z);
+            // 2. Render Agents (sphere impostors sized by the species radius)
+            float* gpuSphere = m_FrameArena.Allocate<float>(agents.size() * 4);
+            unsigned char* gpuColor = m_FrameArena.Allocate<unsigned char>(agents.size() * 4);
+            size_t drawn = 0;
+            for (const Agent& agent : agents) {
+                if (!sampled(agent.id, m_AgentStride)) continue;
+                gpuSphere[drawn * 4 + 0] = agent.position.x;
+                gpuSphere[drawn * 4 + 1] = agent.position.y;
+                gpuSphere[drawn * 4 + 2] = agent.position.z;
+                gpuSphere[drawn * 4 + 3] = agent.Radius();
                 
                 // Color by Type
-                switch (agent.type) {
-                    case STARCH: // White
-                        gpuColor.insert(gpuColor.end(), {0.9f, 0.9f, 0.9f});
-                        break;
-                    case GLUTENIN: // Orange
-                        gpuColor.insert(gpuColor.end(), {1.0f, 0.6f, 0.0f});
-                        break;
-                    case GLIADIN: // Yellow
-                        gpuColor.insert(gpuColor.end(), {1.0f, 0.9f, 0.2f});
-                        break;
-                }
+                const float* color = Interactions::Of(agent.type).color;
+                gpuColor[drawn * 4 + 0] = (unsigned char)(color[0] * 255.0f);
+                gpuColor[drawn * 4 + 1] = (unsigned char)(color[1] * 255.0f);
+                gpuColor[drawn * 4 + 2] = (unsigned char)(color[2] * 255.0f);
+                gpuColor[drawn * 4 + 3] = 255;
+                drawn++;
             }
             
-            glBindBuffer(GL_ARRAY_BUFFER, m_AgentVBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, gpuPos.size() * sizeof(float), gpuPos.data());
-            
-            glBindBuffer(GL_ARRAY_BUFFER, m_ColorVBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, gpuColor.size() * sizeof(float), gpuColor.data());
-
-            glBindVertexArray(m_AgentVAO);
-            shader.SetVec3("u_Color", glm::vec3(1.0f));
-            glDrawArrays(GL_POINTS, 0, agents.size());
-            
-            // 3. Render Mixer
-            /*
-            float mixerPos[] = { m_SimEngine.m_Mixer.position.x, 0.0f, m_SimEngine.m_Mixer.position.z };
-            glBindBuffer(GL_ARRAY_BUFFER, m_AgentVBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, 3 * sizeof(float), mixerPos);
-            shader.SetVec3("u_Color", glm::vec3(1.0f, 0.0f, 0.0f)); // Red Mixer
-            glPointSize(20.0f);
-            glDrawArrays(GL_POINTS, 0, 1);
-            glPointSize(1.0f);
-            */
+            if (drawn > 0) {
+                sphereShader.Use();
+                sphereShader.SetMat4("u_View", view);
+                sphereShader.SetMat4("u_Projection", projection);
+                // A sampled agent keeps roughly the volume of the ones it stands in for
+                sphereShader.SetFloat("u_RadiusScale", std::cbrt((float)m_AgentStride));
+                glBindVertexArray(m_AgentVAO);
+                UploadVertices(m_AgentVBO, m_AgentVBOBytes, gpuSphere, drawn * 4 * sizeof(float));
+                UploadVertices(m_ColorVBO, m_ColorVBOBytes, gpuColor, drawn * 4);
+                glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, drawn);
+                shader.Use();
+            }
             
+            if (m_SimEngine.m_Periodic) {
+                // 3. Render Periodic Box (12 edges; no mixer, the box is sheared instead)
+                const PeriodicBox& box = m_SimEngine.m_Box;
+                float* edges = m_FrameArena.Allocate<float>(24 * 3);
+                float* e = edges;
+                for (int axis = 0; axis < 3; ++axis) {
+                    for (int corner = 0; corner < 4; ++corner) {
+                        glm::vec3 from = box.min;
+                        from[(axis + 1) % 3] += corner & 1 ? box.size[(axis + 1) % 3] : 0.0f;
+                        from[(axis + 2) % 3] += corner & 2 ? box.size[(axis + 2) % 3] : 0.0f;
+                        glm::vec3 to = from;
+                        to[axis] += box.size[axis];
+                        *e++ = from.x; *e++ = from.y; *e++ = from.z;
+                        *e++ = to.x; *e++ = to.y; *e++ = to.z;
+                    }
+                }
+                glBindVertexArray(m_ContainerVAO);
+                UploadVertices(m_ContainerVBO, m_ContainerVBOBytes, edges, 24 * 3 * sizeof(float));
+                glVertexAttrib3f(1, 1.0f, 1.0f, 1.0f);
+                shader.SetVec3("u_Color", glm::vec3(0.5f, 0.5f, 0.5f));
+                glDrawArrays(GL_LINES, 0, 24);
+            } else {
+                // 3. Render Container (Wireframe)
+                const int segments = 64;
+                const int containerVerts = (segments + 1) * 2 + 4;
+                float* containerPts = m_FrameArena.Allocate<float>(containerVerts * 3);
+                float* c = containerPts;
+                float r = m_SimEngine.m_ContainerRadius;
+                float top = m_SimEngine.m_ContainerHeight;
+                for (int i = 0; i <= segments; ++i) {
+                    float theta = 2.0f * 3.14159f * float(i) / float(segments);
+                    *c++ = r * cos(theta); *c++ = -1.0f; *c++ = r * sin(theta); // Floor
+                }
+                // --- Render Lid (Top Circle) ---
+                // We draw the top rim of the container at m_ContainerHeight
+                for (int i = 0; i <= segments; ++i) {
+                    float theta = 2.0f * 3.14159f * float(i) / float(segments);
+                    *c++ = r * cos(theta); *c++ = top; *c++ = r * sin(theta);
+                }
             
-            //NASZ KOMENTARZ
-            //generalnie rod dziala, ale gdy mikser jest punktem i predkosc = 0 to stoi on w idealnym srodku containera. 
-            //problem jest taki ze ten jago domyslny punkt rowniez z jakiegos powodu rysuje linie - czyli sa 2 kinda prostopadle
-            //i kolor nie dziala for some reason
-            //i ZNIKA PUDELKO WTF
-
-            /*
-
-            // Render Mixer as a vertical rod (line)
-            glm::vec3 mixer = m_SimEngine.m_Mixer.position;
-
-           
-
-            // The bottom endpoint moves with the Lissajous pattern
-            glm::vec3 rodTop(0,1,0);
-            glm::vec3 rodBottom(mixer.x, -1.0f, mixer.z);
+                // --- Render Lid Cross ---
+                // Visual aid to help the user see the exact height of the lid
+                const float cross[12] = { -r, top, 0.0f,   r, top, 0.0f,   0.0f, top, -r,   0.0f, top, r };
+                std::copy(cross, cross + 12, c);
             
-
-            // Two endpoints of the rod
-            float rodVertices[] = {
-                rodTop.x,    rodTop.y,    rodTop.z,
-                rodBottom.x, rodBottom.y, rodBottom.z
-            };
-
-            glBindVertexArray(m_RodVAO);
-            glBindBuffer(GL_ARRAY_BUFFER, m_RodVBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(rodVertices), rodVertices);
-            shader.Use();
-            shader.SetVec3("u_Color", glm::vec3(1.0f, 1.0f, 0.0f));
+                glBindVertexArray(m_ContainerVAO);
+                UploadVertices(m_ContainerVBO, m_ContainerVBOBytes, containerPts, containerVerts * 3 * sizeof(float));
+                glVertexAttrib3f(1, 1.0f, 1.0f, 1.0f);
+                shader.SetVec3("u_Color", glm::vec3(0.5f, 0.5f, 0.5f));
+                glDrawArrays(GL_LINE_STRIP, 0, segments + 1); // Bottom
+                glDrawArrays(GL_LINE_STRIP, segments + 1, segments + 1); // Top
+                glDrawArrays(GL_LINES, (segments + 1) * 2, 4); // Lid Cross
             
-            glDrawArrays(GL_LINES, 0, 2);
-
-            */
-
+                // 4. Render Mixer Tool (baked outline moved by the tool transform)
+                const Collider& tool = m_SimEngine.m_Tool;
+                float* toolPts = m_FrameArena.Allocate<float>(tool.outline.size() * 3);
+                for (size_t i = 0; i < tool.outline.size(); ++i) {
+                    glm::vec3 w = tool.ToWorld(tool.outline[i]);
+                    toolPts[i * 3 + 0] = w.x;
+                    toolPts[i * 3 + 1] = w.y;
+                    toolPts[i * 3 + 2] = w.z;
+                }
+                glBindVertexArray(m_RodVAO);
+                UploadVertices(m_RodVBO, m_RodVBOBytes, toolPts, tool.outline.size() * 3 * sizeof(float));
+                glVertexAttrib3f(1, 1.0f, 1.0f, 1.0f); // No color buffer on this VAO, so vColor would be black
+                shader.SetVec3("u_Color", glm::vec3(1.0f, 0.0f, 0.0f));
+                glDrawArrays(GL_LINES, 0, tool.outline.size());
             
-            // 4. Render Container (Wireframe)
-            std::vector<float> containerPts;
-            int segments = 64;
-            float r = m_SimEngine.m_ContainerRadius;
-            for (int i = 0; i <= segments; ++i) {
-                float theta = 2.0f * 3.14159f * float(i) / float(segments);
-                containerPts.push_back(r * cos(theta));
-                containerPts.push_back(-1.0f); // Floor
-                containerPts.push_back(r * sin(theta));
-            }
-            // --- Render Lid (Top Circle) ---
-            // We draw the top rim of the container at m_ContainerHeight
-             for (int i = 0; i <= segments; ++i) {
-                float theta = 2.0f * 3.14159f * float(i) / float(segments);
-                containerPts.push_back(r * cos(theta));
-                containerPts.push_back(m_SimEngine.m_ContainerHeight); // Top (Lid)
-                containerPts.push_back(r * sin(theta));
             }
             
-            // --- Render Lid Cross ---
-            // Visual aid to help the user see the exact height of the lid
-            containerPts.push_back(-r); containerPts.push_back(m_SimEngine.m_ContainerHeight); containerPts.push_back(0.0f);
-            containerPts.push_back(r); containerPts.push_back(m_SimEngine.m_ContainerHeight); containerPts.push_back(0.0f);
-            containerPts.push_back(0.0f); containerPts.push_back(m_SimEngine.m_ContainerHeight); containerPts.push_back(-r);
-            containerPts.push_back(0.0f); containerPts.push_back(m_SimEngine.m_ContainerHeight); containerPts.push_back(r);
-            
-            glBindBuffer(GL_ARRAY_BUFFER, m_AgentVBO);
-            glBufferData(GL_ARRAY_BUFFER, containerPts.size() * sizeof(float), containerPts.data(), GL_DYNAMIC_DRAW); 
-            shader.SetVec3("u_Color", glm::vec3(0.5f, 0.5f, 0.5f));
-            glDrawArrays(GL_LINE_STRIP, 0, segments + 1); // Bottom
-            glDrawArrays(GL_LINE_STRIP, segments + 1, segments + 1); // Top
-            glDrawArrays(GL_LINES, (segments + 1) * 2, 4); // Lid Cross
-            
-            // Restore buffer size for agents next frame
-             glBufferData(GL_ARRAY_BUFFER, 1000 * 3 * sizeof(float), NULL, GL_DYNAMIC_DRAW);
-            
         } else {
             glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT); 
@@ -374,6 +336,15 @@ void Application::MainLoop() {
 
         glfwSwapBuffers(m_Window);
         glfwPollEvents();
+
+        // Debug builds: after warm-up (arena, VBOs and plot buffers at full size) a frame should not allocate
+        m_FrameAllocations = AllocationTracker::GetAllocationCount() - allocationsAtStart;
+        if (++m_FrameCount > ALLOCATION_WARMUP_FRAMES && m_FrameAllocations > 0) {
+            if (m_AllocatingFrames++ == 0) {
+                std::cerr << "Warning: steady-state frame " << m_FrameCount << " made "
+                          << m_FrameAllocations << " heap allocations" << std::endl;
+            }
+        }
     }
     
     glDeleteVertexArrays(1, &m_AgentVAO);
@@ -381,7 +352,8 @@ void Application::MainLoop() {
     glDeleteBuffers(1, &m_ColorVBO);
     glDeleteVertexArrays(1, &m_BondVAO);
     glDeleteBuffers(1, &m_BondVBO);
-    glDeleteBuffers(1, &m_BondColorVBO);
+    glDeleteVertexArrays(1, &m_ContainerVAO);
+    glDeleteBuffers(1, &m_ContainerVBO);
     glDeleteVertexArrays(1, &m_RodVAO);
     glDeleteBuffers(1, &m_RodVBO);
 
@@ -391,6 +363,45 @@ void Application::Run() {
     MainLoop();
 }
 
+// Streams vertex data into a VBO; its storage is only reallocated when it has to grow
+void Application::UploadVertices(unsigned int vbo, size_t& capacity, const void* data, size_t bytes) {
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (bytes > capacity) {
+        capacity = std::max(bytes, capacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, capacity, NULL, GL_DYNAMIC_DRAW);
+    }
+    if (data && bytes > 0) glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, data);
+}
+
+// Pixels covered by the container's (or the periodic box's) bounding box on screen (clipped to the window)
+float Application::ContainerFootprint(const glm::mat4& viewProjection) const {
+    float r = m_SimEngine.m_ContainerRadius;
+    glm::vec3 lower(-r, m_SimEngine.m_FloorY, -r), upper(r, m_SimEngine.m_ContainerHeight, r);
+    if (m_SimEngine.m_Periodic) {
+        lower = m_SimEngine.m_Box.min;
+        upper = lower + m_SimEngine.m_Box.size;
+    }
+    glm::vec2 lo(1.0f), hi(-1.0f);
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec4 p(corner & 1 ? upper.x : lower.x, corner & 2 ? upper.y : lower.y, corner & 4 ? upper.z : lower.z, 1.0f);
+        glm::vec4 clip = viewProjection * p;
+        if (clip.w <= 0.0f) return (float)m_Width * m_Height; // Camera inside the box
+        glm::vec2 ndc = glm::vec2(clip) / clip.w;
+        lo = glm::min(lo, ndc);
+        hi = glm::max(hi, ndc);
+    }
+    lo = glm::max(lo, glm::vec2(-1.0f));
+    hi = glm::min(hi, glm::vec2(1.0f));
+    if (hi.x <= lo.x || hi.y <= lo.y) return 0.0f;
+    return 0.25f * (hi.x - lo.x) * (hi.y - lo.y) * m_Width * m_Height;
+}
+
+// Draw every n-th item so at most m_LodDensity of them land on each pixel of the footprint
+int Application::LodStride(size_t count, float footprint) const {
+    if (m_LodDensity <= 0.0f || footprint <= 0.0f) return 1;
+    return std::max(1, (int)std::ceil(count / (footprint * m_LodDensity)));
+}
+
 void Application::ProcessInput() {
     if (glfwGetKey(m_Window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(m_Window, true);
@@ -401,6 +412,12 @@ void Application::RenderUI() {
     
     ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
     ImGui::Checkbox("Render Simulation (3D)", &m_RenderSimulation);
+    if (m_RenderSimulation) {
+        ImGui::SliderFloat("LOD Density", &m_LodDensity, 0.001f, 1.0f, "%.3f / px", ImGuiSliderFlags_Logarithmic);
+        if (m_AgentStride > 1 || m_BondStride > 1) {
+            ImGui::Text("Drawing 1/%d of the agents, 1/%d of the bonds", m_AgentStride, m_BondStride);
+        }
+    }
     ImGui::Checkbox("Pause", &m_IsPaused);
     ImGui::SliderFloat("Time Scale", &m_TimeScale, 0.0f, 5.0f);
     
@@ -409,9 +426,27 @@ void Application::RenderUI() {
         ImGui::SliderFloat("Rising Rate", &m_SimEngine.m_SpringExpansionRate, 0.0f, 1.0f);
         ImGui::SliderFloat("Bond Probability", &m_SimEngine.m_BondProbability, 0.0f, 1.0f);
         ImGui::Separator();
+        ImGui::Text("Proofing / Baking");
+        ImGui::Checkbox("Local Temperature & CO2", &m_SimEngine.m_UseField);
+        if (m_SimEngine.m_UseField) {
+            ProofingField& field = m_SimEngine.m_Field;
+            ImGui::SliderFloat("Ambient / Oven (C)", &field.m_AmbientTemperature, 0.0f, 250.0f);
+            ImGui::SliderFloat("Yeast Activity", &field.m_YeastRate, 0.0f, 0.2f);
+            ImGui::SliderFloat("Reference Pressure", &m_SimEngine.m_ReferencePressure, 0.05f, 1.0f);
+            ImGui::Text("Dough: %.1f C, CO2 %.2f", field.GetDoughTemperature(), field.GetDoughCO2());
+            if (ImGui::Button("Reset Field")) m_SimEngine.ResetField();
+        }
+        ImGui::Separator();
         ImGui::Text("Volume / Density");
         ImGui::SliderFloat("Collision Radius", &m_SimEngine.m_CollisionRadius, 0.01f, 0.2f);
         ImGui::SliderFloat("Repulsion Stiffness", &m_SimEngine.m_RepulsionK, 1000.0f, 20000.0f);
+        const char* laws[] = { "Linear", "Hertz" };
+        int law = (int)m_SimEngine.m_ContactLaw;
+        if (ImGui::Combo("Contact Law", &law, laws, IM_ARRAYSIZE(laws))) {
+            m_SimEngine.m_ContactLaw = (ContactTable::Law)law;
+        }
+        ImGui::SliderFloat("Starch Adhesion", &m_SimEngine.m_Adhesion, 0.0f, 50.0f);
+        ImGui::SliderFloat("Adhesion Range", &m_SimEngine.m_AdhesionRange, 0.05f, 0.5f);
         ImGui::SliderFloat("Static Friction", &m_SimEngine.m_StaticFriction, 0.0f, 2.0f);
         ImGui::SliderFloat("Dynamic Friction", &m_SimEngine.m_DynamicFriction, 0.0f, 2.0f);
     }
@@ -427,25 +462,265 @@ void Application::RenderUI() {
             ImGui::SliderFloat("Central Force (K)", &m_SimEngine.m_CentralForceK, 0.0f, 20.0f);
         }
         ImGui::SliderFloat("Mixer Speed", &m_SimEngine.m_Mixer.speed, 0.0f, 5.0f);
+        ImGui::SliderFloat("Mixer Spin", &m_SimEngine.m_Mixer.spin, 0.0f, 10.0f);
+        
+        const char* tools[] = { "Rod", "Dough Hook" };
+        int currentTool = (int)m_SimEngine.m_MixerTool;
+        if (ImGui::Combo("Mixer Tool", &currentTool, tools, IM_ARRAYSIZE(tools))) {
+            m_SimEngine.m_MixerTool = (SimulationEngine::MixerTool)currentTool;
+            m_SimEngine.RebuildColliders();
+        }
+
+        // Bulk mode: a sheared periodic box instead of bowl and mixer (switching respawns the agents)
+        // Multi-process mode only runs the bowl, so switching stops the workers first
+        if (ImGui::Checkbox("Periodic Box", &m_SimEngine.m_Periodic)) {
+            m_Domain.Stop();
+            m_SimEngine.Init(m_SpawnCount);
+        }
+        if (m_SimEngine.m_Periodic) {
+            ImGui::SliderInt("Box Cells", &m_SimEngine.m_BoxCells, 3, 40);
+            if (ImGui::IsItemDeactivatedAfterEdit()) m_SimEngine.Init(m_SpawnCount);
+            ImGui::SliderFloat("Shear Rate", &m_SimEngine.m_ShearRate, -5.0f, 5.0f, "%.2f 1/s");
+            float rate = m_SimEngine.m_ShearRate;
+            ImGui::Text("Box %.1f m, shear stress %.1f Pa", m_SimEngine.m_Box.size.x, m_SimEngine.m_ShearStress);
+            if (rate != 0.0f) {
+                ImGui::SameLine();
+                ImGui::Text("(viscosity %.1f Pa s)", m_SimEngine.m_ShearStress / rate);
+            }
+        }
+
+        ImGui::SliderInt("Flour Batch", &m_FlourBatch, 10, 1000);
+        if (ImGui::Button("Add Flour")) m_SimEngine.AddFlour(m_FlourBatch);
+        ImGui::SliderInt("Spawn Count", &m_SpawnCount, 100, 100000, "%d", ImGuiSliderFlags_Logarithmic);
+        ImGui::SliderInt("Spawn Relaxation", &m_SimEngine.m_InitRelaxIterations, 0, 200);
+        if (ImGui::Button("Respawn")) {
+            m_Domain.Stop();
+            m_SimEngine.Init(m_SpawnCount);
+        }
+        ImGui::SameLine();
+        ImGui::Text("Overlap left: %.4f", m_SimEngine.m_InitOverlap);
+        ImGui::Checkbox("Remove Escaped Agents", &m_SimEngine.m_RemoveEscapedAgents);
+        ImGui::Text("Agents: %zu (%d removed)", m_SimEngine.GetAgents().size(), m_SimEngine.m_RemovedAgentsTotal);
+    }
+
+    if (ImGui::CollapsingHeader("Performance")) {
+        ImGui::Checkbox("Task Graph Scheduler", &m_SimEngine.m_UseTaskGraph);
+        ImGui::Checkbox("Incremental Grid", &m_SimEngine.m_IncrementalGrid);
+        ImGui::SliderFloat("Grid Rebuild Fraction", &m_SimEngine.m_Grid.m_RebuildFraction, 0.0f, 1.0f);
+        ImGui::Text("Grid migrations: %d", m_SimEngine.m_Grid.GetLastMigrations());
+        ImGui::Checkbox("Vector Contacts", &m_SimEngine.m_VectorContacts);
+        ImGui::SameLine();
+        ImGui::TextDisabled("(%s)", PackedCells::InstructionSet());
+        ImGui::Checkbox("Spatial Sort", &m_SimEngine.m_SpatialSort);
+        ImGui::SliderFloat("Sort Trigger", &m_SimEngine.m_SortTrigger, 0.0f, 1.0f);
+        ImGui::Text("Locality: %.2f (%.2f after last sort, %d sorts)",
+                    m_SimEngine.m_Locality, m_SimEngine.m_SortedLocality, m_SimEngine.m_SortCount);
+        ImGui::Checkbox("Sleeping Agents", &m_SimEngine.m_AllowSleep);
+        ImGui::Text("Sleeping: %d / %zu", m_SimEngine.m_SleepingCount, m_SimEngine.GetAgents().size());
+        const StepTimings& timings = m_SimEngine.GetStepTimings();
+        for (int p = 0; p < PHASE_COUNT; ++p) ImGui::Text("%-12s %7.3f ms", PHASE_NAMES[p], timings.ms[p]);
+        bool publishing = m_SimEngine.IsPublishingTelemetry();
+        if (ImGui::Checkbox("Publish Telemetry", &publishing)) {
+            if (publishing) m_SimEngine.OpenTelemetry(m_TelemetryStream);
+            else m_SimEngine.CloseTelemetry();
+        }
+        if (publishing) ImGui::Text("Stream: /glutensim-%s", m_TelemetryStream);
+        if (AllocationTracker::IsEnabled()) {
+            ImGui::Text("Heap allocations / frame: %zu", m_FrameAllocations);
+            ImGui::Text("Allocating frames after warm-up: %d", m_AllocatingFrames);
+        }
+        ImGui::Text("Frame arena: %zu / %zu KB", m_FrameArena.GetUsed() / 1024, m_FrameArena.GetCapacity() / 1024);
+        ImGui::Separator();
+        ImGui::Text("Auto-Tuning");
+        ImGui::Checkbox("Tune New Scenarios", &m_AutoTuner.m_Enabled);
+        ImGui::SameLine();
+        if (m_AutoTuner.IsTuning()) ImGui::Text("Probing, simulation held...");
+        else if (ImGui::Button("Tune Now") && !m_Domain.IsRunning() && !m_RheometerJob.valid()) m_AutoTuner.Tune(m_SimEngine, m_FixedStep);
+        ImGui::SliderInt("Threads (0 = default)", &m_SimEngine.m_ThreadCount, 0, (int)std::thread::hardware_concurrency());
+        ImGui::Text("Running %d threads, cell %.3f (reach %.3f)", m_SimEngine.ThreadCount(),
+                    m_SimEngine.m_Grid.GetCellSize(), m_SimEngine.RequiredCellSize());
+        if (!m_AutoTuner.GetScenario().empty()) {
+            ImGui::Text("Scenario %s: %s", m_AutoTuner.GetScenario().c_str(),
+                        m_AutoTuner.WasCached() ? "cached" : m_AutoTuner.IsTuning() ? "probing" : "probed");
+        }
+        if (!m_AutoTuner.WasCached()) {
+            for (const AutoTuner::Probe& probe : m_AutoTuner.GetProbes()) {
+                ImGui::TextDisabled("%2d thr  cell %.3f  %-6s %-10s %7.3f ms", probe.config.threads, probe.config.cellSize,
+                                    probe.config.vectorContacts ? "vector" : "scalar",
+                                    probe.config.taskGraph ? "task graph" : "loops", probe.msPerStep);
+            }
+        }
+        ImGui::Separator();
+        ImGui::Text("Domain Decomposition");
+        if (m_SimEngine.m_Periodic || m_SimEngine.m_UseField) {
+            // The workers only reproduce the bowl; Step stops them if either is switched on meanwhile
+            ImGui::TextDisabled("Not available with the periodic box or proofing field");
+        } else if (!m_Domain.IsRunning()) {
+            ImGui::SliderInt("Worker Processes", &m_DomainWorkers, 1, 8);
+            if (ImGui::Button("Start Workers")) m_Domain.Start(m_SimEngine, m_DomainWorkers);
+        } else {
+            ImGui::Text("Running on %d worker processes", m_Domain.GetWorkerCount());
+            if (ImGui::Button("Stop Workers")) m_Domain.Stop();
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Rheometer")) {
+        RenderRheometerUI();
     }
 
     if (ImGui::CollapsingHeader("Analytics", ImGuiTreeNodeFlags_DefaultOpen)) {
+        // One query per frame for the window both plots share (their x axes are linked to it);
+        // panning or zooming either plot stops following the run
+        if (m_FollowHistory) {
+            m_HistoryWindow[0] = m_History.GetFirstTime();
+            m_HistoryWindow[1] = std::max(m_History.GetLastTime(), m_HistoryWindow[0] + 1.0);
+        }
+        double window[2] = { m_HistoryWindow[0], m_HistoryWindow[1] };
+        m_History.Query(window[0], window[1], HISTORY_POINTS, m_HistoryView);
+        ImGui::Checkbox("Follow Run", &m_FollowHistory);
+        ImGui::SameLine();
+        ImGui::TextDisabled("%zu samples, tier %d", m_History.GetSampleCount(), m_HistoryView.tier);
+        bool spilling = m_History.IsSpilling();
+        if (ImGui::Checkbox("Record to Disk", &spilling)) {
+            if (spilling) {
+                m_HistorySpillFailed = !m_History.OpenSpill(m_HistoryPath, (size_t)std::max(m_HistoryLimitMB, 1) << 20);
+                if (m_HistorySpillFailed) std::cerr << "Cannot write " << m_HistoryPath << std::endl;
+            } else {
+                m_History.CloseSpill();
+            }
+        }
+        if (spilling) {
+            ImGui::TextDisabled("Full history: %s", m_History.GetSpillPath().c_str());
+        } else {
+            ImGui::InputText("History File", m_HistoryPath, sizeof(m_HistoryPath));
+            ImGui::InputInt("Limit (MB)", &m_HistoryLimitMB);
+            if (m_HistorySpillFailed) ImGui::TextDisabled("Cannot write %s", m_HistoryPath);
+            else if (m_History.SpillReachedLimit()) ImGui::TextDisabled("Stopped at the size limit: %s", m_History.GetSpillPath().c_str());
+        }
+        const double* time = m_HistoryView.time.data();
+        int points = m_HistoryView.Count();
+
         if (ImPlot::BeginPlot("Network Stats", ImVec2(-1, 300))) { // Increased height
-            ImPlot::SetupAxes("Time (s)", "Count", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
-            ImPlot::PlotLine("Total Bonds", m_PlotTime.data(), m_PlotBonds.data(), m_PlotTime.size());
-            ImPlot::PlotLine("Broken Bonds", m_PlotTime.data(), m_PlotBroken.data(), m_PlotTime.size());
+            ImPlot::SetupAxes("Time (s)", "Count", ImPlotAxisFlags_None, ImPlotAxisFlags_AutoFit);
+            ImPlot::SetupAxisLinks(ImAxis_X1, &m_HistoryWindow[0], &m_HistoryWindow[1]);
+            ImPlot::PlotLine("Total Bonds", time, m_HistoryView.values[HISTORY_BONDS].data(), points);
+            ImPlot::PlotLine("Broken Bonds", time, m_HistoryView.values[HISTORY_BROKEN].data(), points);
             ImPlot::EndPlot();
         }
         
         if (ImPlot::BeginPlot("Rheology", ImVec2(-1, 300))) { // Increased height
-             ImPlot::SetupAxes("Time (s)", "Young's Modulus (Pa)", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
-            ImPlot::PlotLine("Young's Modulus", m_PlotTime.data(), m_PlotYoungs.data(), m_PlotTime.size());
+            ImPlot::SetupAxes("Time (s)", "Young's Modulus (Pa)", ImPlotAxisFlags_None, ImPlotAxisFlags_AutoFit);
+            ImPlot::SetupAxisLinks(ImAxis_X1, &m_HistoryWindow[0], &m_HistoryWindow[1]);
+            ImPlot::PlotLine("Young's Modulus", time, m_HistoryView.values[HISTORY_YOUNGS].data(), points);
             ImPlot::EndPlot();
         }
+        if (window[0] != m_HistoryWindow[0] || window[1] != m_HistoryWindow[1]) m_FollowHistory = false;
     }
 
     ImGui::End();
 }
+
+void Application::RenderRheometerUI() {
+    bool running = m_RheometerJob.valid();
+    if (running && m_RheometerJob.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        m_RheometerResults = m_RheometerJob.get();
+        running = false;
+        // Plot series are built once here, not every frame
+        m_SweepX.clear(); m_SweepStorage.clear(); m_SweepLoss.clear();
+        m_AmplitudeSweep = m_RheometerResults.size() > 1 &&
+                           m_RheometerResults[0].test.amplitude != m_RheometerResults[1].test.amplitude;
+        for (const auto& r : m_RheometerResults) {
+            m_SweepX.push_back(m_AmplitudeSweep ? r.test.amplitude : r.test.frequency);
+            m_SweepStorage.push_back(r.storageModulus);
+            m_SweepLoss.push_back(r.lossModulus);
+        }
+    }
+
+    ImGui::Combo("Test", &m_RheometerMode, "Tensile\0Compression\0Amplitude Sweep\0Frequency Sweep\0");
+    Rheometer::Test& test = m_RheometerTest;
+    switch (m_RheometerMode) {
+        case RHEO_TENSILE:
+        case RHEO_COMPRESSION:
+            ImGui::SliderFloat("Max Strain", &test.maxStrain, 0.05f, 1.0f);
+            ImGui::SliderFloat("Strain Rate (1/s)", &test.strainRate, 0.05f, 2.0f);
+            break;
+        case RHEO_AMPLITUDE_SWEEP:
+            ImGui::DragFloat2("Amplitude Range", m_SweepRange, 0.005f, 0.001f, 1.0f);
+            ImGui::SliderFloat("Frequency (Hz)", &test.frequency, 0.1f, 5.0f);
+            ImGui::SliderInt("Points", &m_SweepPoints, 2, 12);
+            break;
+        case RHEO_FREQUENCY_SWEEP:
+            ImGui::DragFloat2("Frequency Range (Hz)", m_SweepRange, 0.05f, 0.1f, 10.0f);
+            ImGui::SliderFloat("Amplitude", &test.amplitude, 0.005f, 0.5f);
+            ImGui::SliderInt("Points", &m_SweepPoints, 2, 12);
+            break;
+    }
+    ImGui::SliderFloat("Clamp Fraction", &m_Rheometer.m_ClampFraction, 0.05f, 0.3f);
+
+    if (running) {
+        ImGui::Text("Measuring...");
+    } else if (m_AutoTuner.IsTuning()) {
+        ImGui::TextDisabled("Waiting for the auto-tuner...");
+    } else if (ImGui::Button("Measure Current Dough")) {
+        std::vector<Rheometer::Test> tests;
+        switch (m_RheometerMode) {
+            case RHEO_TENSILE: test.protocol = Rheometer::TENSILE; tests.push_back(test); break;
+            case RHEO_COMPRESSION: test.protocol = Rheometer::COMPRESSION; tests.push_back(test); break;
+            case RHEO_AMPLITUDE_SWEEP:
+                tests = Rheometer::AmplitudeSweep(m_SweepRange[0], m_SweepRange[1], m_SweepPoints, test.frequency);
+                break;
+            case RHEO_FREQUENCY_SWEEP:
+                tests = Rheometer::FrequencySweep(m_SweepRange[0], m_SweepRange[1], m_SweepPoints, test.amplitude);
+                break;
+        }
+        // The snapshot is taken here, the interactive simulation keeps running while it is measured
+        m_RheometerJob = std::async(std::launch::async,
+            [rheometer = m_Rheometer, sample = m_SimEngine.Clone(), tests]() { return rheometer.Run(*sample, tests); });
+    }
+
+    if (m_RheometerResults.empty()) return;
+    const Rheometer::Result& first = m_RheometerResults.front();
+    if (first.test.protocol != Rheometer::OSCILLATORY_SHEAR) {
+        ImGui::Text("Young's modulus: %.1f Pa", first.modulus);
+        ImGui::Text("Peak stress: %.1f Pa", first.peakStress);
+        if (first.failureStrain >= 0.0f) ImGui::Text("Failure strain: %.3f", first.failureStrain);
+        else ImGui::Text("Failure strain: no failure");
+        ImGui::Text("Bonds broken: %d", first.brokenBonds);
+        if (ImPlot::BeginPlot("Stress-Strain", ImVec2(-1, 250))) {
+            ImPlot::SetupAxes("Strain", "Stress (Pa)", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            ImPlot::PlotLine("Stress", first.strain.data(), first.stress.data(), (int)first.strain.size());
+            ImPlot::EndPlot();
+        }
+        return;
+    }
+
+    // Sweep: G' and G'' against the swept variable
+    if (ImGui::BeginTable("Moduli", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn(m_AmplitudeSweep ? "Amplitude" : "Frequency (Hz)");
+        ImGui::TableSetupColumn("G' (Pa)");
+        ImGui::TableSetupColumn("G'' (Pa)");
+        ImGui::TableSetupColumn("Broken");
+        ImGui::TableHeadersRow();
+        for (size_t i = 0; i < m_RheometerResults.size(); ++i) {
+            const auto& r = m_RheometerResults[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", m_SweepX[i]);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", r.storageModulus);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", r.lossModulus);
+            ImGui::TableNextColumn(); ImGui::Text("%d", r.brokenBonds);
+        }
+        ImGui::EndTable();
+    }
+    if (ImPlot::BeginPlot("Moduli", ImVec2(-1, 250))) {
+        ImPlot::SetupAxes(m_AmplitudeSweep ? "Strain Amplitude" : "Frequency (Hz)", "Modulus (Pa)",
+                          ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Log10);
+        ImPlot::PlotLine("G'", m_SweepX.data(), m_SweepStorage.data(), (int)m_SweepX.size());
+        ImPlot::PlotLine("G''", m_SweepX.data(), m_SweepLoss.data(), (int)m_SweepX.size());
+        ImPlot::EndPlot();
+    }
+}
+
 void Application::Cleanup() {
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
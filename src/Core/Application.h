@@ -2,7 +2,13 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <vector>
+#include <future>
 #include "Simulation/SimulationEngine.h"
+#include "Simulation/DomainDecomposition.h"
+#include "Simulation/Rheometer.h"
+#include "Simulation/AutoTuner.h"
+#include "FrameArena.h"
+#include "TimeSeries.h"
 
 // ImGui / ImPlot
 #include "imgui.h"
@@ -23,28 +29,71 @@ private:
     void Cleanup();
     void ProcessInput();
     void RenderUI(); // New UI Method
+    void RenderRheometerUI();
+    void UploadVertices(unsigned int vbo, size_t& capacity, const void* data, size_t bytes);
+    float ContainerFootprint(const glm::mat4& viewProjection) const;
+    int LodStride(size_t count, float footprint) const;
 
     GLFWwindow* m_Window;
     int m_Width, m_Height;
     const char* m_Title;
     
     SimulationEngine m_SimEngine;
+    DomainDecomposition m_Domain;    // Multi-process mode, steps m_SimEngine's state on worker processes
+    int m_DomainWorkers = 2;
+    AutoTuner m_AutoTuner;           // Threads, cell size and strategy per scenario, cached in autotune.cache
+    char m_TelemetryStream[32];      // Shared-memory stream name, from the start time
     float m_TimeAccumulator = 0.0f;
     const float m_FixedStep = 0.01f; // Fizyka liczy się zawsze co 10ms (100 FPS)
     
     // Rendering
+    // Agents are instanced sphere impostors (position + radius, RGBA8 color per instance)
     unsigned int m_AgentVAO, m_AgentVBO, m_ColorVBO;
-    unsigned int m_BondVAO, m_BondVBO, m_BondColorVBO;
-    unsigned int m_RodVAO, m_RodVBO, m_RodColorVBO;
-    
+    unsigned int m_BondVAO, m_BondVBO;
+    unsigned int m_ContainerVAO, m_ContainerVBO;
+    unsigned int m_RodVAO, m_RodVBO;
+    size_t m_AgentVBOBytes = 0, m_ColorVBOBytes = 0, m_BondVBOBytes = 0, m_ContainerVBOBytes = 0, m_RodVBOBytes = 0;
+
+    // Level of detail: above this many agents (or bonds) per pixel of the container's screen footprint,
+    // only every n-th one is drawn, picked by ID so the subset does not flicker when agents are re-sorted
+    float m_LodDensity = 0.05f;
+    int m_AgentStride = 1;
+    int m_BondStride = 1;
+
+    // Per-frame temporaries (vertex staging), recycled at the start of every frame
+    FrameArena m_FrameArena;
+    static constexpr int ALLOCATION_WARMUP_FRAMES = 300;
+    size_t m_FrameAllocations = 0;  // operator new calls during the last frame, all threads (debug builds)
+    int m_FrameCount = 0;
+    int m_AllocatingFrames = 0;     // Frames past warm-up that still allocated
     
     // UI / Plot Data
     bool m_RenderSimulation = true;
     float m_TimeScale = 1.0f;
     bool m_IsPaused = false;
+    int m_FlourBatch = 100;
+    int m_SpawnCount = 1000;            // Agents placed by Init / Respawn
     
-    std::vector<float> m_PlotTime;
-    std::vector<float> m_PlotBonds;
-    std::vector<float> m_PlotBroken;
-    std::vector<float> m_PlotYoungs;
+    // Analytics history of the whole run (see TimeSeries.h), plotted over a shared time window
+    enum HistoryChannel { HISTORY_BONDS, HISTORY_BROKEN, HISTORY_YOUNGS, HISTORY_CHANNELS };
+    static constexpr int HISTORY_POINTS = 2000;     // Per line, whatever the window spans
+    TimeSeries m_History{ { "bonds", "broken_bonds", "youngs_modulus" } };
+    TimeSeries::Envelope m_HistoryView;
+    double m_HistoryWindow[2] = { 0.0, 1.0 };
+    bool m_FollowHistory = true;        // Window tracks the whole run until the plots are panned or zoomed
+    char m_HistoryPath[256];            // Full-resolution spill, off until "Record to Disk" is ticked
+    int m_HistoryLimitMB = 256;         // Spill stops once the file reaches this size
+    bool m_HistorySpillFailed = false;
+
+    // Virtual rheometer, runs on a snapshot in the background
+    enum RheometerMode { RHEO_TENSILE, RHEO_COMPRESSION, RHEO_AMPLITUDE_SWEEP, RHEO_FREQUENCY_SWEEP };
+    Rheometer m_Rheometer;
+    int m_RheometerMode = RHEO_TENSILE;
+    Rheometer::Test m_RheometerTest;
+    float m_SweepRange[2] = { 0.01f, 0.5f };
+    int m_SweepPoints = 5;
+    std::future<std::vector<Rheometer::Result>> m_RheometerJob;
+    std::vector<Rheometer::Result> m_RheometerResults;
+    bool m_AmplitudeSweep = false;
+    std::vector<float> m_SweepX, m_SweepStorage, m_SweepLoss;
 };
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Linear allocator for per-frame temporaries (vertex staging, scratch arrays).
+// Reset() at the start of a frame recycles everything; the main block only grows,
+// once, when a frame needed more than it has ever had. Nothing is constructed or destroyed,
+// so only use it for trivially destructible types.
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity = 1 << 20) { Grow(capacity); }
+
+    template<typename T>
+    T* Allocate(size_t count) {
+        size_t bytes = count * sizeof(T);
+        size_t offset = (m_Offset + alignof(T) - 1) & ~(alignof(T) - 1);
+        m_Requested = offset + bytes;
+
+        if (offset + bytes <= m_Capacity) {
+            m_Offset = offset + bytes;
+            return reinterpret_cast<T*>(m_Block.get() + offset);
+        }
+
+        // Out of space this frame: earlier pointers must stay valid, so use a side block
+        m_Overflow.emplace_back(new char[bytes + alignof(T)]);
+        m_Offset = offset + bytes;
+        char* raw = m_Overflow.back().get();
+        size_t misalign = reinterpret_cast<size_t>(raw) % alignof(T);
+        return reinterpret_cast<T*>(raw + (misalign ? alignof(T) - misalign : 0));
+    }
+
+    void Reset() {
+        if (!m_Overflow.empty()) {
+            m_Overflow.clear();
+            Grow(std::max(m_Requested, m_Offset) * 2);
+        }
+        m_Offset = 0;
+        m_Requested = 0;
+    }
+
+    size_t GetUsed() const { return m_Offset; }
+    size_t GetCapacity() const { return m_Capacity; }
+
+private:
+    std::unique_ptr<char[]> m_Block;
+    size_t m_Capacity = 0;
+    size_t m_Offset = 0;
+    size_t m_Requested = 0;
+    std::vector<std::unique_ptr<char[]>> m_Overflow;
+
+    void Grow(size_t capacity) {
+        m_Block.reset(new char[capacity]);
+        m_Capacity = capacity;
+    }
+};
@@ -0,0 +1,212 @@
+#include "TimeSeries.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+    const int SPILL_FLUSH_RECORDS = 256;    // Spill records between fflush calls
+}
+
+TimeSeries::TimeSeries(std::vector<std::string> channels) : m_Channels(std::move(channels)), m_Tiers(TIERS) {
+    size_t channelCount = m_Channels.size();
+    for (Tier& tier : m_Tiers) {
+        tier.start.resize(TIER_CAPACITY);
+        tier.end.resize(TIER_CAPACITY);
+        tier.min.resize(TIER_CAPACITY * channelCount);
+        tier.max.resize(TIER_CAPACITY * channelCount);
+        tier.pendingMin.resize(channelCount);
+        tier.pendingMax.resize(channelCount);
+    }
+}
+
+TimeSeries::~TimeSeries() {
+    CloseSpill();
+}
+
+void TimeSeries::Append(double time, const float* values) {
+    if (m_SampleCount == 0) m_FirstTime = time;
+    m_LastTime = time;
+    m_SampleCount++;
+    Push(0, time, time, values, values);
+
+    size_t recordBytes = sizeof(time) + sizeof(float) * m_Channels.size();
+    if (m_Spill && m_SpillLimit > 0 && m_SpillBytes + recordBytes > m_SpillLimit) {
+        CloseSpill();
+        m_SpillFull = true;
+    }
+    if (m_Spill) {
+        std::fwrite(&time, sizeof(time), 1, m_Spill);
+        std::fwrite(values, sizeof(float), m_Channels.size(), m_Spill);
+        m_SpillBytes += recordBytes;
+        // stdio buffers the writes; flushing now and then bounds what a crash loses
+        if (++m_UnflushedRecords >= SPILL_FLUSH_RECORDS) {
+            std::fflush(m_Spill);
+            m_UnflushedRecords = 0;
+        }
+    }
+}
+
+void TimeSeries::Push(int level, double start, double end, const float* min, const float* max) {
+    size_t channelCount = m_Channels.size();
+    Tier& tier = m_Tiers[level];
+    int slot;
+    if (tier.count < TIER_CAPACITY) {
+        slot = Slot(tier, tier.count++);
+    } else {
+        // Full: the oldest bucket is overwritten, the coarser tiers still summarize it
+        slot = tier.head;
+        tier.head = (tier.head + 1) % TIER_CAPACITY;
+        tier.dropped = true;
+    }
+    tier.start[slot] = start;
+    tier.end[slot] = end;
+    std::copy(min, min + channelCount, tier.min.begin() + slot * channelCount);
+    std::copy(max, max + channelCount, tier.max.begin() + slot * channelCount);
+
+    if (level + 1 >= TIERS) return;
+    Tier& parent = m_Tiers[level + 1];
+    if (parent.pending == 0) {
+        parent.pendingStart = start;
+        std::copy(min, min + channelCount, parent.pendingMin.begin());
+        std::copy(max, max + channelCount, parent.pendingMax.begin());
+    } else {
+        for (size_t c = 0; c < channelCount; ++c) {
+            parent.pendingMin[c] = std::min(parent.pendingMin[c], min[c]);
+            parent.pendingMax[c] = std::max(parent.pendingMax[c], max[c]);
+        }
+    }
+    parent.pendingEnd = end;
+    if (++parent.pending == TIER_FACTOR) {
+        Push(level + 1, parent.pendingStart, parent.pendingEnd, parent.pendingMin.data(), parent.pendingMax.data());
+        parent.pending = 0;
+    }
+}
+
+void TimeSeries::Clear() {
+    for (Tier& tier : m_Tiers) {
+        tier.head = 0;
+        tier.count = 0;
+        tier.pending = 0;
+        tier.dropped = false;
+    }
+    m_SampleCount = 0;
+    m_FirstTime = m_LastTime = 0.0;
+}
+
+bool TimeSeries::OpenSpill(const char* path, size_t maxBytes) {
+    CloseSpill();
+    m_SpillFull = false;
+    m_Spill = std::fopen(path, "ab");
+    if (!m_Spill) return false;
+    m_SpillPath = path;
+    m_UnflushedRecords = 0;
+    m_SpillLimit = maxBytes;
+    // Reopening the same file continues its records (and counts them against the limit)
+    std::fseek(m_Spill, 0, SEEK_END);
+    long existing = std::ftell(m_Spill);
+    m_SpillBytes = existing > 0 ? (size_t)existing : 0;
+    if (existing > 0) return true;
+
+    const uint32_t version = 1;
+    uint32_t channelCount = (uint32_t)m_Channels.size();
+    std::fwrite("GSTS", 1, 4, m_Spill);
+    std::fwrite(&version, sizeof(version), 1, m_Spill);
+    std::fwrite(&channelCount, sizeof(channelCount), 1, m_Spill);
+    for (const std::string& name : m_Channels) {
+        uint32_t length = (uint32_t)name.size();
+        std::fwrite(&length, sizeof(length), 1, m_Spill);
+        std::fwrite(name.data(), 1, length, m_Spill);
+    }
+    std::fflush(m_Spill);
+    m_SpillBytes = (size_t)std::ftell(m_Spill);
+    return true;
+}
+
+void TimeSeries::CloseSpill() {
+    if (!m_Spill) return;
+    std::fclose(m_Spill);
+    m_Spill = nullptr;
+}
+
+int TimeSeries::FirstEndingAfter(const Tier& tier, double t) const {
+    int lo = 0, hi = tier.count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (tier.end[Slot(tier, mid)] < t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+int TimeSeries::FirstStartingAfter(const Tier& tier, double t) const {
+    int lo = 0, hi = tier.count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (tier.start[Slot(tier, mid)] <= t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+void TimeSeries::Query(double t0, double t1, int maxPoints, Envelope& out) const {
+    size_t channelCount = m_Channels.size();
+    out.time.clear();
+    out.values.resize(channelCount);
+    for (auto& values : out.values) values.clear();
+    out.tier = 0;
+    if (m_SampleCount == 0 || t1 < t0) return;
+
+    // Finest tier that reaches back to t0 (or to the first sample) within the budget. Tier 0 draws a point
+    // per sample, the others two per bucket, plus one bucket for the samples the tier has not completed yet.
+    int level = TIERS - 1;
+    int first = 0, last = 0;
+    for (int k = 0; k < TIERS; ++k) {
+        const Tier& tier = m_Tiers[k];
+        bool covers = !tier.dropped || tier.start[tier.head] <= t0;
+        int from = FirstEndingAfter(tier, t0);
+        int to = FirstStartingAfter(tier, t1);
+        int points = k == 0 ? to - from : 2 * (to - from + 1);
+        if ((covers && points <= std::max(maxPoints, 4)) || k == TIERS - 1) {
+            level = k;
+            first = from;
+            last = to;
+            break;
+        }
+    }
+
+    const Tier& tier = m_Tiers[level];
+    out.tier = level;
+    for (int i = first; i < last; ++i) {
+        int slot = Slot(tier, i);
+        double mid = 0.5 * (tier.start[slot] + tier.end[slot]);
+        out.time.push_back(mid);
+        if (level > 0) out.time.push_back(mid);
+        for (size_t c = 0; c < channelCount; ++c) {
+            out.values[c].push_back(tier.min[slot * channelCount + c]);
+            if (level > 0) out.values[c].push_back(tier.max[slot * channelCount + c]);
+        }
+    }
+
+    // Samples newer than the tier's last bucket wait in the pending buckets of this and the finer tiers
+    // (coarsest first = oldest first); merged, they close the envelope up to the latest sample
+    int oldest = 0, newest = 0;
+    for (int k = level; k >= 1; --k) {
+        if (!m_Tiers[k].pending) continue;
+        if (!oldest) oldest = k;
+        newest = k;
+    }
+    if (!oldest) return;
+    double start = m_Tiers[oldest].pendingStart, end = m_Tiers[newest].pendingEnd;
+    if (end < t0 || start > t1) return;
+    out.time.push_back(0.5 * (start + end));
+    out.time.push_back(0.5 * (start + end));
+    for (size_t c = 0; c < channelCount; ++c) {
+        float min = m_Tiers[oldest].pendingMin[c], max = m_Tiers[oldest].pendingMax[c];
+        for (int k = oldest - 1; k >= newest; --k) {
+            if (!m_Tiers[k].pending) continue;
+            min = std::min(min, m_Tiers[k].pendingMin[c]);
+            max = std::max(max, m_Tiers[k].pendingMax[c]);
+        }
+        out.values[c].push_back(min);
+        out.values[c].push_back(max);
+    }
+}
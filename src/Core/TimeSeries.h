@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Run history for the analytics plots: a fixed number of float channels sampled at increasing times.
+// Memory stays bounded however long the run: tier 0 is a ring of the latest raw samples, and every
+// coarser tier is a ring of min/max buckets that each summarize TIER_FACTOR buckets of the tier below,
+// so the coarsest tiers reach back to the start of the run. Query() picks the finest tier that still
+// covers the requested window in at most the requested number of points, so a plot costs the same at
+// any zoom level and run length. Optionally every raw sample is also appended to a file (the spill),
+// which keeps the full-resolution record on disk until it reaches its size limit.
+//
+// Spill format (native endianness): "GSTS", uint32 version 1, uint32 channel count, per channel a
+// uint32 name length and the name bytes; then records of a double time and one float per channel.
+class TimeSeries {
+public:
+    static constexpr int TIERS = 10;
+    static constexpr int TIER_CAPACITY = 2048;  // Buckets per tier
+    static constexpr int TIER_FACTOR = 4;       // Tier k buckets span TIER_FACTOR^k samples
+
+    // Min/max envelope of a window: two points per bucket (its min, then its max, at the bucket's middle
+    // time), so a line through them covers every excursion the bucket saw. time and values[channel]
+    // keep their capacity between queries.
+    struct Envelope {
+        std::vector<double> time;
+        std::vector<std::vector<double>> values;
+        int tier = 0;
+        int Count() const { return (int)time.size(); }
+    };
+
+    explicit TimeSeries(std::vector<std::string> channels);
+    ~TimeSeries();
+    TimeSeries(const TimeSeries&) = delete;
+    TimeSeries& operator=(const TimeSeries&) = delete;
+
+    // values: one per channel; times must not decrease
+    void Append(double time, const float* values);
+    // Drops the in-memory history (the spill file keeps what it has)
+    void Clear();
+
+    // Appends to a spill file (a new one gets the header); false if it cannot be opened. The spill
+    // closes itself once the file would grow past maxBytes (0: no limit).
+    bool OpenSpill(const char* path, size_t maxBytes = 0);
+    void CloseSpill();
+    bool IsSpilling() const { return m_Spill != nullptr; }
+    bool SpillReachedLimit() const { return m_SpillFull; }
+    const std::string& GetSpillPath() const { return m_SpillPath; }
+
+    int GetChannelCount() const { return (int)m_Channels.size(); }
+    const std::string& GetChannelName(int channel) const { return m_Channels[channel]; }
+    size_t GetSampleCount() const { return m_SampleCount; }
+    double GetFirstTime() const { return m_FirstTime; }
+    double GetLastTime() const { return m_LastTime; }
+
+    // Envelope of the samples in [t0, t1] in at most maxPoints points (at least 2 buckets' worth)
+    void Query(double t0, double t1, int maxPoints, Envelope& out) const;
+
+private:
+    // One ring of buckets, plus the bucket it is collecting from the tier below
+    struct Tier {
+        std::vector<double> start, end;     // [TIER_CAPACITY]
+        std::vector<float> min, max;        // [TIER_CAPACITY][channels]
+        int head = 0;                       // Oldest bucket
+        int count = 0;
+        bool dropped = false;               // Buckets were overwritten, the ring no longer reaches the start
+        int pending = 0;                    // Buckets of the tier below merged into the next one
+        double pendingStart = 0.0, pendingEnd = 0.0;
+        std::vector<float> pendingMin, pendingMax;
+    };
+
+    std::vector<std::string> m_Channels;
+    std::vector<Tier> m_Tiers;
+    size_t m_SampleCount = 0;
+    double m_FirstTime = 0.0, m_LastTime = 0.0;
+
+    std::FILE* m_Spill = nullptr;
+    std::string m_SpillPath;
+    int m_UnflushedRecords = 0;
+    size_t m_SpillBytes = 0, m_SpillLimit = 0;
+    bool m_SpillFull = false;
+
+    void Push(int tier, double start, double end, const float* min, const float* max);
+    int Slot(const Tier& tier, int i) const { return (tier.head + i) % TIER_CAPACITY; }
+    // First bucket (in age order) ending at or after t, and first starting after t
+    int FirstEndingAfter(const Tier& tier, double t) const;
+    int FirstStartingAfter(const Tier& tier, double t) const;
+};
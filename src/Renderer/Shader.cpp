@@ -68,12 +68,16 @@ void Shader::Use() {
     glUseProgram(ID);
 }
 
-void Shader::SetMat4(const std::string &name, const glm::mat4 &mat) const {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::SetMat4(const char* name, const glm::mat4 &mat) const {
+    glUniformMatrix4fv(glGetUniformLocation(ID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::SetVec3(const std::string &name, const glm::vec3 &value) const {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+void Shader::SetVec3(const char* name, const glm::vec3 &value) const {
+    glUniform3fv(glGetUniformLocation(ID, name), 1, &value[0]);
+}
+
+void Shader::SetFloat(const char* name, float value) const {
+    glUniform1f(glGetUniformLocation(ID, name), value);
 }
 
 void Shader::CheckCompileErrors(unsigned int shader, std::string type) {
@@ -13,8 +13,9 @@ public:
     void Use();
     
     // Funkcje do wysyłania danych do shadera (Uniforms)
-    void SetMat4(const std::string &name, const glm::mat4 &mat) const;
-    void SetVec3(const std::string &name, const glm::vec3 &value) const;
+    void SetMat4(const char* name, const glm::mat4 &mat) const;
+    void SetVec3(const char* name, const glm::vec3 &value) const;
+    void SetFloat(const char* name, float value) const;
 
 private:
     void CheckCompileErrors(unsigned int shader, std::string type);
@@ -1,30 +1,40 @@
 #pragma once
 #include <glm/glm.hpp>
 #include <vector>
-
-
-enum AgentType { GLUTENIN, GLIADIN, STARCH};
+#include "Interactions.h"
 
 struct Agent {
     int id;
+    AgentType type;
+    bool isFixed;
+    bool isGhost;           // Halo copy owned by another worker process (read-only here)
+    bool isSleeping;        // At rest: not moved and no forces evaluated until something wakes it
     glm::vec3 position;
     glm::vec3 prevPosition; 
     glm::vec3 velocity;     
     glm::vec3 force;
-    float mass;
-    float radius;
-    bool isFixed;
-    AgentType type;
     
     // Chemistry Memory
-    int maxBonds;
     std::vector<int> connectedAgentIDs;
 
-    Agent(int id, glm::vec3 pos, AgentType t) 
-        : id(id), position(pos), prevPosition(pos), type(t), velocity(0.0f), force(0.0f), isFixed(false)
-    {
-        if (type == STARCH) { mass = 10.0f; radius = 0.05f; maxBonds = 0; }
-        else if (type == GLUTENIN) { mass = 2.0f; radius = 0.03f; maxBonds = 4; }
-        else if (type == GLIADIN) { mass = 1.0f; radius = 0.02f; maxBonds = 2; }
+    // Per-type constants live in Interactions::SPECIES, not in every agent
+    float Mass() const { return Interactions::Of(type).mass; }
+    float InvMass() const { return Interactions::Of(type).invMass; }
+    float Radius() const { return Interactions::Of(type).radius; }
+    int MaxBonds() const { return Interactions::Of(type).maxBonds; }
+
+    Agent(int id, glm::vec3 pos, AgentType t) { Reset(id, pos, t); }
+
+    // Re-initialises the agent in place; the bond list keeps its capacity
+    void Reset(int newId, glm::vec3 pos, AgentType t) {
+        id = newId;
+        type = t;
+        isFixed = false;
+        isGhost = false;
+        isSleeping = false;
+        position = prevPosition = pos;
+        velocity = force = glm::vec3(0.0f);
+        connectedAgentIDs.clear();
+        connectedAgentIDs.reserve(MaxBonds()); // Bonding never reallocates
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include "Agent.h"
+#include <vector>
+#include <algorithm>
+
+// Stable reference to an agent. Indices into m_Agents change whenever agents are added, removed or
+// re-sorted; a handle keeps naming the same agent until it is removed, and is stale afterwards
+// even if its slot was reused.
+struct AgentHandle {
+    int slot = -1;
+    unsigned int generation = 0;
+
+    bool operator==(const AgentHandle& o) const { return slot == o.slot && generation == o.generation; }
+    bool operator!=(const AgentHandle& o) const { return !(*this == o); }
+};
+
+// Slot table behind the handles. A slot is the agent's ID (Agent::id), so IDs stay small and dense
+// (the domain decomposition sizes its ID tables by the largest one). Removed slots go to a free list
+// and get a new generation before they are handed out again. Generations outlive Reset, so handles
+// taken before a respawn stay stale.
+class AgentPool {
+public:
+    // Slots 0..count-1 in use, e.g. after Init numbered the agents. Every slot that existed before
+    // gets a new generation; the table keeps slots past count for when they are handed out again.
+    void Reset(int count) {
+        for (unsigned int& generation : m_Generation) generation++;
+        if ((int)m_Generation.size() < count) m_Generation.resize(count, 0);
+        m_Index.assign(count, -1);
+        m_Free.clear();
+    }
+
+    int Acquire() {
+        if (!m_Free.empty()) {
+            int slot = m_Free.back();
+            m_Free.pop_back();
+            return slot;
+        }
+        m_Index.push_back(-1);
+        if (m_Index.size() > m_Generation.size()) m_Generation.push_back(0);
+        return (int)m_Index.size() - 1;
+    }
+
+    void Release(int slot) {
+        m_Index[slot] = -1;
+        m_Generation[slot]++;
+        m_Free.push_back(slot);
+    }
+
+    // Re-reads where every agent lives, call after agents moved inside the array.
+    // IDs past the table (agents imported from elsewhere) get fresh slots.
+    void Reindex(const std::vector<Agent>& agents) {
+        std::fill(m_Index.begin(), m_Index.end(), -1);
+        for (int i = 0; i < (int)agents.size(); ++i) {
+            int slot = agents[i].id;
+            if (slot >= (int)m_Index.size()) m_Index.resize(slot + 1, -1);
+            if (slot >= (int)m_Generation.size()) m_Generation.resize(slot + 1, 0);
+            m_Index[slot] = i;
+        }
+    }
+
+    AgentHandle HandleOf(int slot) const { return { slot, m_Generation[slot] }; }
+
+    // Index in m_Agents, -1 for stale handles and agents not inserted yet
+    int IndexOf(AgentHandle handle) const {
+        if (handle.slot < 0 || handle.slot >= (int)m_Index.size()) return -1;
+        if (m_Generation[handle.slot] != handle.generation) return -1;
+        return m_Index[handle.slot];
+    }
+
+    int SlotCount() const { return (int)m_Index.size(); }
+
+private:
+    std::vector<int> m_Index;                   // Slot -> index in m_Agents (-1 = free or pending)
+    std::vector<unsigned int> m_Generation;     // Per slot, at least as long as m_Index
+    std::vector<int> m_Free;
+};
@@ -0,0 +1,200 @@
+#include "AutoTuner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+AutoTuner::Scenario AutoTuner::Describe(const SimulationEngine& engine) {
+    Scenario scenario;
+    size_t count = engine.GetAgents().size();
+    scenario.countBucket = count > 0 ? (int)std::lround(2.0 * std::log2((double)count)) : 0;
+    scenario.reach = (int)std::lround(engine.RequiredCellSize() * 100.0f);
+    scenario.periodic = engine.m_Periodic;
+    return scenario;
+}
+
+std::string AutoTuner::MachineKey() {
+    char key[64];
+    std::snprintf(key, sizeof(key), "%s-%ut", PackedCells::InstructionSet(), std::thread::hardware_concurrency());
+    return key;
+}
+
+std::string AutoTuner::ScenarioKey(const Scenario& scenario) {
+    char key[64];
+    std::snprintf(key, sizeof(key), "%s-n%d-r%d", scenario.periodic ? "box" : "bowl", scenario.countBucket, scenario.reach);
+    return key;
+}
+
+AutoTuner::Config AutoTuner::Capture(const SimulationEngine& engine) {
+    Config config;
+    config.threads = engine.ThreadCount();
+    config.cellSize = engine.m_Grid.GetCellSize();
+    config.vectorContacts = engine.m_VectorContacts;
+    config.taskGraph = engine.m_UseTaskGraph;
+    return config;
+}
+
+void AutoTuner::Apply(const Config& config, SimulationEngine& engine) {
+    engine.m_ThreadCount = config.threads;
+    engine.ApplyThreadCount();
+    // The periodic box is laid out in grid cells, its cell size is fixed until the next Init
+    float cellSize = std::max(config.cellSize, engine.RequiredCellSize());
+    if (!engine.m_Periodic && cellSize != engine.m_Grid.GetCellSize()) engine.m_Grid.Resize(cellSize);
+    engine.m_VectorContacts = config.vectorContacts;
+    engine.m_UseTaskGraph = config.taskGraph;
+}
+
+bool AutoTuner::Maintain(SimulationEngine& engine, float dt) {
+    bool applied = false;
+    if (m_Job.valid() && m_Job.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        Outcome outcome = m_Job.get();
+        m_Probes = std::move(outcome.probes);
+        Store(MachineKey() + " " + ScenarioKey(outcome.scenario), outcome.best);
+        // If the scenario moved on while probing, the result waits in the cache for it to come back
+        if (outcome.scenario == m_Scenario) {
+            Apply(outcome.best, engine);
+            applied = true;
+        }
+    }
+
+    if (engine.GetAgents().empty()) return applied;
+    Scenario scenario = Describe(engine);
+    if (scenario == m_Scenario) {
+        m_Candidate = scenario;
+        return applied;
+    }
+    if (!(scenario == m_Candidate)) {
+        m_Candidate = scenario;
+        m_CandidateFrames = 0;
+    }
+    // Settled scenarios are taken up once the running probes are done
+    if (++m_CandidateFrames < m_SettleFrames || m_Job.valid()) return applied;
+    m_Scenario = scenario;
+    m_ScenarioName = ScenarioKey(scenario);
+
+    Config config;
+    if (Lookup(MachineKey() + " " + m_ScenarioName, config)) {
+        Apply(config, engine);
+        m_FromCache = true;
+        return true;
+    }
+    if (m_Enabled) Tune(engine, dt);
+    return applied;
+}
+
+float AutoTuner::Measure(const SimulationEngine& engine, const Config& config, float dt, std::vector<Probe>& probes) const {
+    for (const Probe& probe : probes) {
+        if (probe.config == config) return probe.msPerStep;
+    }
+    using Clock = std::chrono::steady_clock;
+    std::unique_ptr<SimulationEngine> sample = engine.Clone();
+    Apply(config, *sample);
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < m_WarmupSteps; ++i) sample->Update(dt);
+    // Large scenarios get fewer timed steps, so a full tune stays within a few seconds
+    float warmupMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count() / std::max(m_WarmupSteps, 1);
+    int steps = std::clamp((int)(m_ProbeBudgetMs / std::max(warmupMs, 1e-3f)), 3, std::max(m_ProbeSteps, 3));
+    start = Clock::now();
+    for (int i = 0; i < steps; ++i) sample->Update(dt);
+    float ms = std::chrono::duration<float, std::milli>(Clock::now() - start).count() / steps;
+    probes.push_back({ config, ms });
+    return ms;
+}
+
+void AutoTuner::Tune(const SimulationEngine& engine, float dt) {
+    if (m_Job.valid()) return;
+    m_Scenario = m_Candidate = Describe(engine);
+    m_ScenarioName = ScenarioKey(m_Scenario);
+    m_FromCache = false;
+    m_Probes.clear();
+    // The snapshot is taken here, the interactive simulation keeps running while it is probed
+    m_Job = std::async(std::launch::async, [this, snapshot = engine.Clone(), scenario = m_Scenario, dt]() {
+        return Search(*snapshot, scenario, dt);
+    });
+}
+
+AutoTuner::Outcome AutoTuner::Search(const SimulationEngine& snapshot, const Scenario& scenario, float dt) const {
+    Outcome outcome;
+    outcome.scenario = scenario;
+    std::vector<Probe>& probes = outcome.probes;
+
+    Config best = Capture(snapshot);
+    float bestMs = Measure(snapshot, best, dt, probes);
+    // A candidate has to win clearly: probes are short, and a coin flip should not move the setting
+    auto consider = [&](const Config& candidate) {
+        float ms = Measure(snapshot, candidate, dt, probes);
+        if (ms < bestMs * (1.0f - m_Margin)) {
+            bestMs = ms;
+            best = candidate;
+        }
+    };
+
+    // Strategy: contact kernel and scheduler
+    Config base = best;
+    for (int strategy = 0; strategy < 4; ++strategy) {
+        Config candidate = base;
+        candidate.vectorContacts = (strategy & 1) == 0;
+        candidate.taskGraph = (strategy & 2) != 0;
+        consider(candidate);
+    }
+
+    // Cell size: from the search reach (fewest candidates per cell) to half again as wide (fewer cells to visit)
+    if (!snapshot.m_Periodic) {
+        base = best;
+        float reach = snapshot.RequiredCellSize();
+        for (float factor : { 1.0f, 1.15f, 1.3f, 1.5f }) {
+            Config candidate = base;
+            candidate.cellSize = reach * factor;
+            consider(candidate);
+        }
+    }
+
+    // Threads: all, halves down to one (OpenMP and the task pool alike)
+    base = best;
+    int hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = hardware; threads >= 1; threads /= 2) {
+        Config candidate = base;
+        candidate.threads = threads;
+        consider(candidate);
+    }
+
+    outcome.best = best;
+    return outcome;
+}
+
+// Cache lines: "<machine> <scenario> <threads> <cell size> <vector contacts> <task graph>"
+bool AutoTuner::Lookup(const std::string& key, Config& config) const {
+    std::ifstream file(m_CachePath);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, key.size() + 1, key + " ") != 0) continue;
+        std::istringstream fields(line.substr(key.size() + 1));
+        Config found;
+        if (fields >> found.threads >> found.cellSize >> found.vectorContacts >> found.taskGraph) {
+            config = found;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AutoTuner::Store(const std::string& key, const Config& config) const {
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(m_CachePath);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.compare(0, key.size() + 1, key + " ") != 0) lines.push_back(line);
+        }
+    }
+    char entry[64];
+    std::snprintf(entry, sizeof(entry), " %d %.4f %d %d", config.threads, config.cellSize,
+                  (int)config.vectorContacts, (int)config.taskGraph);
+    lines.push_back(key + entry);
+
+    std::ofstream file(m_CachePath, std::ios::trunc);
+    for (const std::string& line : lines) file << line << '\n';
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "SimulationEngine.h"
+#include <future>
+#include <string>
+#include <vector>
+
+// Picks the step configuration that runs the current scenario fastest on this machine: thread count,
+// grid cell size and contact / scheduling strategy. Tune() times short probes on clones of the engine,
+// one setting at a time (strategy, then cell size, then threads, each starting from the best so far),
+// and applies the winner. Results are cached per machine and scenario in a text file, so restarting or
+// returning to a scenario only looks them up. Maintain() re-tunes when the scenario changes: the agent
+// count by more than a factor of sqrt(2), the search reach (RequiredCellSize, in cm steps) or the
+// boundary mode. A change has to hold for m_SettleFrames calls first, so dragging a slider or agents
+// leaving the bowl do not set off a lookup or probe per frame. Probes run on a background thread, on
+// a snapshot, so the caller's frame loop keeps going; it must not step anything meanwhile
+// (IsTuning()), or the timings would measure the contention and be cached as this machine's best.
+class AutoTuner {
+public:
+    struct Config {
+        int threads = 0;
+        float cellSize = 0.2f;
+        bool vectorContacts = true;
+        bool taskGraph = false;
+        bool operator==(const Config& o) const {
+            return threads == o.threads && cellSize == o.cellSize && vectorContacts == o.vectorContacts &&
+                   taskGraph == o.taskGraph;
+        }
+    };
+    struct Probe {
+        Config config;
+        float msPerStep;
+    };
+
+    bool m_Enabled = true;              // Maintain() probes unknown scenarios (cache hits are always applied)
+    int m_SettleFrames = 30;            // Maintain() calls a changed scenario must hold before it counts
+    int m_WarmupSteps = 2;              // Untimed steps per probe (grid rebuild, pool start-up)
+    int m_ProbeSteps = 15;              // Timed steps per probe, at most
+    float m_ProbeBudgetMs = 200.0f;     // ... and fewer (down to 3) when they would take longer than this
+    float m_Margin = 0.05f;             // Share by which a candidate must beat the best so far
+    std::string m_CachePath = "autotune.cache";
+
+    // Cheap unless the scenario changed or a probe finished; true if a configuration was applied
+    bool Maintain(SimulationEngine& engine, float dt);
+    // Starts probing a snapshot of 'engine' in the background (nothing if probes already run);
+    // the next Maintain() after they finish applies the fastest configuration and caches it
+    void Tune(const SimulationEngine& engine, float dt);
+    bool IsTuning() const { return m_Job.valid(); }
+
+    static Config Capture(const SimulationEngine& engine);
+    static void Apply(const Config& config, SimulationEngine& engine);
+
+    const std::string& GetScenario() const { return m_ScenarioName; }
+    const std::vector<Probe>& GetProbes() const { return m_Probes; }   // Of the last finished Tune()
+    bool WasCached() const { return m_FromCache; }
+
+private:
+    // Scenario identity, compared every frame without building strings
+    struct Scenario {
+        int countBucket = -1;           // round(2 log2(agent count))
+        int reach = 0;                  // RequiredCellSize in cm
+        bool periodic = false;
+        bool operator==(const Scenario& o) const {
+            return countBucket == o.countBucket && reach == o.reach && periodic == o.periodic;
+        }
+    };
+    // What a background Tune() found
+    struct Outcome {
+        Scenario scenario;
+        Config best;
+        std::vector<Probe> probes;
+    };
+    Scenario m_Scenario;                // Last settled scenario
+    Scenario m_Candidate;               // Differs from m_Scenario, waiting to settle
+    int m_CandidateFrames = 0;
+    std::string m_ScenarioName;
+    bool m_FromCache = false;
+    std::vector<Probe> m_Probes;
+
+    static Scenario Describe(const SimulationEngine& engine);
+    static std::string MachineKey();
+    static std::string ScenarioKey(const Scenario& scenario);
+    Outcome Search(const SimulationEngine& snapshot, const Scenario& scenario, float dt) const;
+    float Measure(const SimulationEngine& engine, const Config& config, float dt, std::vector<Probe>& probes) const;
+    bool Lookup(const std::string& key, Config& config) const;
+    void Store(const std::string& key, const Config& config) const;
+
+    // Declared last: destroyed first, it waits for a running Search() while the settings it reads still exist
+    std::future<Outcome> m_Job;
+};
@@ -0,0 +1,136 @@
+#include "Collider.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+void SDFGrid::Bake(const glm::vec3& minCorner, const glm::vec3& maxCorner, float cell,
+                   const std::function<float(const glm::vec3&)>& sdf) {
+    origin = minCorner;
+    cellSize = cell;
+    glm::vec3 extent = maxCorner - minCorner;
+    nx = std::max(2, (int)std::ceil(extent.x / cell) + 1);
+    ny = std::max(2, (int)std::ceil(extent.y / cell) + 1);
+    nz = std::max(2, (int)std::ceil(extent.z / cell) + 1);
+    values.assign((size_t)nx * ny * nz, 0.0f);
+
+    // Baking happens once per tool, the per-node cost of the analytic shape does not matter
+    #pragma omp parallel for
+    for (int z = 0; z < nz; ++z) {
+        for (int y = 0; y < ny; ++y) {
+            for (int x = 0; x < nx; ++x) {
+                glm::vec3 p = origin + glm::vec3(x, y, z) * cellSize;
+                values[x + y * nx + z * nx * ny] = sdf(p);
+            }
+        }
+    }
+}
+
+float SDFGrid::Sample(const glm::vec3& p, glm::vec3& outGradient) const {
+    glm::vec3 g = (p - origin) / cellSize;
+    glm::vec3 c = glm::clamp(g, glm::vec3(0.0f), glm::vec3(nx - 1.001f, ny - 1.001f, nz - 1.001f));
+
+    int x = (int)c.x, y = (int)c.y, z = (int)c.z;
+    float fx = c.x - x, fy = c.y - y, fz = c.z - z;
+
+    float c000 = At(x, y, z),         c100 = At(x + 1, y, z);
+    float c010 = At(x, y + 1, z),     c110 = At(x + 1, y + 1, z);
+    float c001 = At(x, y, z + 1),     c101 = At(x + 1, y, z + 1);
+    float c011 = At(x, y + 1, z + 1), c111 = At(x + 1, y + 1, z + 1);
+
+    // Interpolate along X first, then reuse the edges for the Y/Z derivatives
+    float c00 = c000 + (c100 - c000) * fx;
+    float c10 = c010 + (c110 - c010) * fx;
+    float c01 = c001 + (c101 - c001) * fx;
+    float c11 = c011 + (c111 - c011) * fx;
+    float c0 = c00 + (c10 - c00) * fy;
+    float c1 = c01 + (c11 - c01) * fy;
+    float value = c0 + (c1 - c0) * fz;
+
+    float dx0 = (c100 - c000) + ((c110 - c010) - (c100 - c000)) * fy;
+    float dx1 = (c101 - c001) + ((c111 - c011) - (c101 - c001)) * fy;
+    glm::vec3 gradient(dx0 + (dx1 - dx0) * fz,
+                       (c10 - c00) + ((c11 - c01) - (c10 - c00)) * fz,
+                       c1 - c0);
+
+    // Beyond the baked box: extend the field by the distance to the box
+    glm::vec3 outsideDir = g - c;
+    float outside = glm::length(outsideDir);
+    if (outside > 0.001f) {
+        outsideDir /= outside;
+        if (solidOutside) {
+            value -= outside * cellSize;
+            gradient = -outsideDir;
+        } else {
+            value += outside * cellSize;
+            gradient = outsideDir;
+        }
+    }
+
+    float len = glm::length(gradient);
+    outGradient = (len > 1e-6f) ? gradient / len : glm::vec3(0.0f, 1.0f, 0.0f);
+    return value;
+}
+
+void Collider::SetTransform(const glm::vec3& position, float angleY) {
+    translation = position;
+    rotation = glm::mat3(glm::rotate(glm::mat4(1.0f), angleY, glm::vec3(0.0f, 1.0f, 0.0f)));
+}
+
+namespace {
+    float SegmentDistance(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b) {
+        glm::vec3 ab = b - a;
+        float t = glm::clamp(glm::dot(p - a, ab) / glm::dot(ab, ab), 0.0f, 1.0f);
+        return glm::length(p - (a + ab * t));
+    }
+
+    // Union of capsules along a polyline, also recorded as the wireframe outline
+    Collider MakePolylineTool(const std::vector<glm::vec3>& points, float radius) {
+        Collider tool;
+        glm::vec3 lo(1e9f), hi(-1e9f);
+        for (const auto& p : points) {
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+        glm::vec3 margin(radius + 0.1f);
+
+        tool.field.solidOutside = false;
+        tool.field.Bake(lo - margin, hi + margin, std::min(0.025f, radius * 0.5f), [&](const glm::vec3& p) {
+            float d = 1e9f;
+            for (size_t i = 0; i + 1 < points.size(); ++i) {
+                d = std::min(d, SegmentDistance(p, points[i], points[i + 1]));
+            }
+            return d - radius;
+        });
+
+        for (size_t i = 0; i + 1 < points.size(); ++i) {
+            tool.outline.push_back(points[i]);
+            tool.outline.push_back(points[i + 1]);
+        }
+        tool.material = { 0.0f, 1.0f };
+        return tool;
+    }
+}
+
+namespace Colliders {
+    Collider MakeRod(float radius, float bottomY, float topY) {
+        return MakePolylineTool({ glm::vec3(0.0f, bottomY, 0.0f), glm::vec3(0.0f, topY, 0.0f) }, radius);
+    }
+
+    Collider MakeDoughHook(float radius, float bottomY, float topY) {
+        // Vertical shaft that bends out and winds one turn of a spiral down to the bottom
+        std::vector<glm::vec3> points;
+        float hookTop = bottomY + 0.3f * (topY - bottomY);
+        points.push_back(glm::vec3(0.0f, topY, 0.0f));
+        points.push_back(glm::vec3(0.0f, hookTop, 0.0f));
+
+        const int segments = 12;
+        const float hookRadius = 0.25f;
+        for (int i = 1; i <= segments; ++i) {
+            float t = float(i) / float(segments);
+            float angle = t * 2.0f * 3.14159f;
+            float r = hookRadius * std::min(1.0f, t * 3.0f);
+            points.push_back(glm::vec3(r * std::cos(angle), hookTop + (bottomY - hookTop) * t, r * std::sin(angle)));
+        }
+        return MakePolylineTool(points, radius);
+    }
+}
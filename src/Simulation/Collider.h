@@ -0,0 +1,59 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <functional>
+
+// Signed distance field sampled on a regular grid of nodes.
+// Negative inside the solid, positive in free space.
+struct SDFGrid {
+    glm::vec3 origin = glm::vec3(0.0f);
+    float cellSize = 0.05f;
+    int nx = 0, ny = 0, nz = 0;
+    bool solidOutside = false; // What lies beyond the baked box (container = solid, tool = free space)
+    std::vector<float> values;
+
+    void Bake(const glm::vec3& minCorner, const glm::vec3& maxCorner, float cell,
+              const std::function<float(const glm::vec3&)>& sdf);
+
+    // One trilinear lookup; the gradient comes from the same 8 corners
+    float Sample(const glm::vec3& p, glm::vec3& outGradient) const;
+
+private:
+    float At(int x, int y, int z) const { return values[x + y * nx + z * nx * ny]; }
+};
+
+// Contact response of a collider surface
+struct ColliderMaterial {
+    float restitution = 0.5f;           // Fraction of normal velocity kept after a bounce
+    float friction = 0.9f;              // Fraction of tangential velocity kept on contact
+};
+
+// Static or moving tool geometry baked into an SDF.
+// Moving tools keep their field in local space and only update the rigid transform.
+struct Collider {
+    SDFGrid field;
+    std::vector<glm::vec3> outline;     // Local-space line segments (pairs) for the wireframe
+    glm::mat3 rotation = glm::mat3(1.0f);
+    glm::vec3 translation = glm::vec3(0.0f);
+    ColliderMaterial material;
+
+    void SetTransform(const glm::vec3& position, float angleY);
+
+    // World-space signed distance and outward normal
+    float Distance(const glm::vec3& worldPos, glm::vec3& outNormal) const {
+        glm::vec3 local = glm::transpose(rotation) * (worldPos - translation);
+        glm::vec3 gradient;
+        float d = field.Sample(local, gradient);
+        outNormal = rotation * gradient;
+        return d;
+    }
+
+    glm::vec3 ToWorld(const glm::vec3& local) const { return rotation * local + translation; }
+};
+
+namespace Colliders {
+    // Straight vertical stick (the old infinite mixer cylinder, now with ends)
+    Collider MakeRod(float radius, float bottomY, float topY);
+    // Shaft with a spiral hook at the bottom, meant to spin around Y
+    Collider MakeDoughHook(float radius, float bottomY, float topY);
+}
@@ -0,0 +1,48 @@
+#include "ContactTable.h"
+#include <cmath>
+
+bool ContactTable::Update(const Settings& settings) {
+    if (m_Built && settings == m_Settings) return false;
+    m_Settings = settings;
+    m_Built = true;
+
+    m_Samples.resize(AGENT_TYPE_COUNT * AGENT_TYPE_COUNT * SAMPLES);
+    m_MaxCutoff = 0.0f;
+    for (int a = 0; a < AGENT_TYPE_COUNT; ++a) {
+        for (int b = 0; b < AGENT_TYPE_COUNT; ++b) {
+            const Interactions::Pair& pair = Interactions::Between((AgentType)a, (AgentType)b);
+            float cutoff = pair.contactDistance;
+            if (settings.adhesion * pair.adhesionScale > 0.0f) cutoff *= 1.0f + settings.adhesionRange;
+            float step = cutoff * cutoff / (SAMPLES - 1);
+            m_Cutoff2[a][b] = cutoff * cutoff;
+            m_MaxCutoff = std::max(m_MaxCutoff, cutoff);
+            m_InvStep[a][b] = 1.0f / step;
+
+            float* table = m_Samples.data() + (a * AGENT_TYPE_COUNT + b) * SAMPLES;
+            for (int i = 0; i < SAMPLES; ++i) {
+                // F / r grows without bound as r -> 0: the first interval is sampled at its far end
+                float r = std::sqrt(std::max(i, 1) * step);
+                table[i] = Force((AgentType)a, (AgentType)b, r) / r;
+            }
+        }
+    }
+    return true;
+}
+
+float ContactTable::Force(AgentType a, AgentType b, float r) const {
+    const Interactions::Pair& pair = Interactions::Between(a, b);
+    float contact = pair.contactDistance;
+    if (r < contact) {
+        float overlap = contact - r;
+        float k = m_Settings.repulsionK * pair.repulsionScale;
+        if (m_Settings.law == HERTZ) return k * overlap * std::sqrt(overlap / contact);
+        return k * overlap;
+    }
+    // Adhesive well: zero at contact and at the cutoff, deepest halfway (a smooth bump, no kink at either end)
+    float width = contact * m_Settings.adhesionRange;
+    float pull = m_Settings.adhesion * pair.adhesionScale;
+    if (pull <= 0.0f || width <= 0.0f || r >= contact + width) return 0.0f;
+    float x = (r - contact) / width;
+    float bump = 4.0f * x * (1.0f - x);
+    return -pull * bump * bump;
+}
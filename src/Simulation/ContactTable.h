@@ -0,0 +1,53 @@
+#pragma once
+#include "Interactions.h"
+#include <algorithm>
+#include <vector>
+
+// Contact force laws between species, sampled into tables so the pair kernels evaluate any law
+// (Hertzian contact, an adhesive well) for the cost of the plain linear overlap spring.
+// For every (type, type) pair F(r) / r is stored at SAMPLES points uniform in r^2 from 0 to the pair's
+// cutoff^2: a kernel turns a squared distance into the force d * scale with one linear interpolation,
+// without sqrt, pow or exp. Positive scales push apart, negative ones pull together.
+class ContactTable {
+public:
+    enum Law { LINEAR, HERTZ };
+    struct Settings {
+        float repulsionK = 0.0f;        // Stiffness at full overlap, times Pair::repulsionScale
+        Law law = LINEAR;               // LINEAR: K * overlap, HERTZ: K * overlap^1.5 / sqrt(contact distance)
+        float adhesion = 0.0f;          // Peak pull (N) of adhesive pairs, times Pair::adhesionScale
+        float adhesionRange = 0.0f;     // Width of the adhesive well past contact, fraction of the contact distance
+        bool operator==(const Settings& o) const {
+            return repulsionK == o.repulsionK && law == o.law && adhesion == o.adhesion && adhesionRange == o.adhesionRange;
+        }
+    };
+    static constexpr int SAMPLES = 512;
+
+    // Resamples the tables if the settings changed since the last call; true if it did
+    bool Update(const Settings& settings);
+    const Settings& GetSettings() const { return m_Settings; }
+
+    // Force magnitude of the analytic law at distance r (what the tables sample)
+    float Force(AgentType a, AgentType b, float r) const;
+
+    float Cutoff2(AgentType a, AgentType b) const { return m_Cutoff2[a][b]; }
+    float MaxCutoff() const { return m_MaxCutoff; }     // Over all pairs: the reach a neighbour search needs
+    float InvStep(AgentType a, AgentType b) const { return m_InvStep[a][b]; }
+    // Tables of an agent of type a against every candidate type, SAMPLES apart
+    const float* Row(AgentType a) const { return m_Samples.data() + a * AGENT_TYPE_COUNT * SAMPLES; }
+
+    // F(r) / r for r^2 = d2 below the cutoff
+    float Scale(AgentType a, AgentType b, float d2) const {
+        const float* table = Row(a) + b * SAMPLES;
+        float x = d2 * m_InvStep[a][b];
+        int i = std::min((int)x, SAMPLES - 2);
+        return table[i] + (x - i) * (table[i + 1] - table[i]);
+    }
+
+private:
+    Settings m_Settings;
+    bool m_Built = false;
+    float m_MaxCutoff = 0.0f;
+    float m_Cutoff2[AGENT_TYPE_COUNT][AGENT_TYPE_COUNT] = {};
+    float m_InvStep[AGENT_TYPE_COUNT][AGENT_TYPE_COUNT] = {};
+    std::vector<float> m_Samples;       // [a][b][SAMPLES]
+};
@@ -0,0 +1,558 @@
+#include "DomainDecomposition.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <signal.h>
+#include <spawn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+void DomainDecomposition::WriteParams(const SimulationEngine& engine, Params& params) {
+    params.gravityMode = (int)engine.m_GravityMode;
+    params.mixerTool = (int)engine.m_MixerTool;
+    params.damping = engine.m_Damping;
+    params.springK = engine.m_SpringK;
+    params.repulsionK = engine.m_RepulsionK;
+    params.contactLaw = (int)engine.m_ContactLaw;
+    params.adhesion = engine.m_Adhesion;
+    params.adhesionRange = engine.m_AdhesionRange;
+    params.collisionRadius = engine.m_CollisionRadius;
+    params.staticFriction = engine.m_StaticFriction;
+    params.dynamicFriction = engine.m_DynamicFriction;
+    params.bondDistance = engine.m_BondDistance;
+    params.breakingThreshold = engine.m_BreakingThreshold;
+    params.minSpringLength = engine.m_MinSpringLength;
+    params.springExpansionRate = engine.m_SpringExpansionRate;
+    params.maxSpringLength = engine.m_MaxSpringLength;
+    params.temperature = engine.m_Temperature;
+    params.bondProbability = engine.m_BondProbability;
+    params.centralForceK = engine.m_CentralForceK;
+    params.mixerSpeed = engine.m_Mixer.speed;
+    params.mixerSpin = engine.m_Mixer.spin;
+}
+
+void DomainDecomposition::ReadParams(const Params& params, SimulationEngine& engine) {
+    engine.m_GravityMode = (SimulationEngine::GravityMode)params.gravityMode;
+    engine.m_MixerTool = (SimulationEngine::MixerTool)params.mixerTool;
+    engine.m_Damping = params.damping;
+    engine.m_SpringK = params.springK;
+    engine.m_RepulsionK = params.repulsionK;
+    engine.m_ContactLaw = (ContactTable::Law)params.contactLaw;
+    engine.m_Adhesion = params.adhesion;
+    engine.m_AdhesionRange = params.adhesionRange;
+    engine.m_CollisionRadius = params.collisionRadius;
+    engine.m_StaticFriction = params.staticFriction;
+    engine.m_DynamicFriction = params.dynamicFriction;
+    engine.m_BondDistance = params.bondDistance;
+    engine.m_BreakingThreshold = params.breakingThreshold;
+    engine.m_MinSpringLength = params.minSpringLength;
+    engine.m_SpringExpansionRate = params.springExpansionRate;
+    engine.m_MaxSpringLength = params.maxSpringLength;
+    engine.m_Temperature = params.temperature;
+    engine.m_BondProbability = params.bondProbability;
+    engine.m_CentralForceK = params.centralForceK;
+    engine.m_Mixer.speed = params.mixerSpeed;
+    engine.m_Mixer.spin = params.mixerSpin;
+}
+
+float DomainDecomposition::HaloWidth(const SimulationEngine& engine) {
+    // Every bond partner and every contact of an owned agent must be visible as a ghost.
+    // Adhesion reaches past contact (ContactTable clamps the range the same way)
+    float contact = Interactions::MaxContactDistance();
+    if (engine.m_Adhesion > 0.0f) contact *= 1.0f + std::clamp(engine.m_AdhesionRange, 0.0f, 0.5f);
+    float reach = std::max({ engine.m_BreakingThreshold, engine.m_BondDistance, engine.m_CollisionRadius, contact });
+    return reach + 0.05f;
+}
+
+const char* DomainDecomposition::Unsupported(const SimulationEngine& engine) {
+    // Params only describe the bowl: workers would rebuild a bowl around periodic-box agents, and each
+    // would proof on a field of its own
+    if (engine.m_Periodic) return "the periodic box";
+    if (engine.m_UseField) return "the proofing field";
+    return nullptr;
+}
+
+#ifdef _WIN32
+
+bool DomainDecomposition::Start(SimulationEngine&, int) {
+    std::cerr << "Domain decomposition is only available on POSIX systems" << std::endl;
+    return false;
+}
+void DomainDecomposition::Stop() {}
+void DomainDecomposition::Step(SimulationEngine& engine, float dt) { engine.Update(dt); }
+int DomainDecomposition::RunWorker(const char*, int) { return -1; }
+
+#else
+
+namespace {
+    const long LIVENESS_POLL_NS = 100 * 1000000L;  // How often a waiting party checks on the others
+
+    // Process-shared barrier that gives up when a party can no longer arrive: pthread_barrier_wait has
+    // no timeout, so one crashed worker would block the coordinator (and the UI) forever
+    struct StepBarrier {
+        pthread_mutex_t mutex;          // Robust: a party may die holding it
+        pthread_cond_t cond;
+        int parties;
+        int arrived;
+        unsigned generation;
+    };
+
+    void InitBarrier(StepBarrier& barrier, int parties) {
+        pthread_mutexattr_t mutexAttr;
+        pthread_mutexattr_init(&mutexAttr);
+        pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&barrier.mutex, &mutexAttr);
+        pthread_mutexattr_destroy(&mutexAttr);
+
+        pthread_condattr_t condAttr;
+        pthread_condattr_init(&condAttr);
+        pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+        pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+        pthread_cond_init(&barrier.cond, &condAttr);
+        pthread_condattr_destroy(&condAttr);
+
+        barrier.parties = parties;
+        barrier.arrived = 0;
+        barrier.generation = 0;
+    }
+
+    void DestroyBarrier(StepBarrier& barrier) {
+        pthread_cond_destroy(&barrier.cond);
+        pthread_mutex_destroy(&barrier.mutex);
+    }
+
+    // The fields are only written under the mutex, so a dead holder leaves nothing half-done
+    void Recover(StepBarrier& barrier, int result) {
+        if (result == EOWNERDEAD) pthread_mutex_consistent(&barrier.mutex);
+    }
+
+    // True once every party arrived; false as soon as alive() reports that one never will
+    template<typename Alive>
+    bool WaitBarrier(StepBarrier& barrier, Alive alive) {
+        Recover(barrier, pthread_mutex_lock(&barrier.mutex));
+        unsigned generation = barrier.generation;
+        bool released = true;
+        if (++barrier.arrived == barrier.parties) {
+            barrier.arrived = 0;
+            barrier.generation++;
+            pthread_cond_broadcast(&barrier.cond);
+        }
+        while (barrier.generation == generation) {
+            timespec deadline;
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_nsec += LIVENESS_POLL_NS;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            int result = pthread_cond_timedwait(&barrier.cond, &barrier.mutex, &deadline);
+            Recover(barrier, result);
+            if (result == ETIMEDOUT && barrier.generation == generation && !alive()) {
+                barrier.arrived--;
+                released = false;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&barrier.mutex);
+        return released;
+    }
+}
+
+struct DomainDecomposition::Header {
+    StepBarrier barrier;                // Process-shared, workers + coordinator
+    int coordinator;                    // PID of the coordinating process
+    int workerCount;
+    int capacity;                       // Records per slot
+    int totalAgents;                    // Largest agent ID + 1
+    int quit;
+    float dt;
+    float time;
+    float containerRadius, floorY, containerHeight;
+    float slabWidth;
+    float haloWidth;
+    Params params;
+    int counts[MAX_WORKERS];
+    int brokenBonds[MAX_WORKERS];       // Cumulative per worker
+};
+
+namespace {
+    // The header is padded to a page so the record slots start aligned
+    size_t HeaderBytes() { return 4096; }
+
+    DomainDecomposition::AgentRecord* Slot(void* header, int capacity, int index) {
+        return (DomainDecomposition::AgentRecord*)((char*)header + HeaderBytes()) + (size_t)index * capacity;
+    }
+
+    int SlabOf(float x, float containerRadius, float slabWidth, int workerCount) {
+        int slab = (int)std::floor((x + containerRadius) / slabWidth);
+        return std::min(std::max(slab, 0), workerCount - 1);
+    }
+
+    // glutensim-worker in the directory of the running program
+    std::string DefaultWorkerPath() {
+        char exe[4096];
+        ssize_t length = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+        if (length <= 0) return "glutensim-worker";
+        std::string path(exe, (size_t)length);
+        return path.substr(0, path.find_last_of('/') + 1) + "glutensim-worker";
+    }
+}
+
+void DomainDecomposition::Import(SimulationEngine& engine, Header* header, int index) {
+    auto& agents = engine.m_Agents;
+    size_t used = 0; // Existing slots are reset in place so their bond lists keep capacity
+    bool hasInactive = false;
+    engine.m_Springs.clear();
+    engine.m_Grid.Invalidate(); // Same buffer, different agents
+    engine.m_SleepingCount = 0; // Imported agents start awake
+    m_LocalIndex.assign(header->totalAgents, -1);
+
+    int n = header->workerCount;
+    int first = 0, last = n - 1;
+    float lo = -1e9f, hi = 1e9f;
+    if (index >= 0) {
+        // Halo wider than a slab reaches past the direct neighbours
+        int reach = (int)std::ceil(header->haloWidth / header->slabWidth);
+        first = std::max(0, index - reach);
+        last = std::min(n - 1, index + reach);
+        lo = -header->containerRadius + index * header->slabWidth - header->haloWidth;
+        hi = lo + header->slabWidth + 2.0f * header->haloWidth;
+    }
+
+    m_Records.clear();
+
+    for (int s = first; s <= last; ++s) {
+        const AgentRecord* slot = Slot(header, header->capacity, s);
+        for (int i = 0; i < header->counts[s]; ++i) {
+            const AgentRecord& r = slot[i];
+            // Ownership follows position, so agents that crossed a boundary migrate here
+            bool owned = index < 0 || SlabOf(r.position.x, header->containerRadius, header->slabWidth, n) == index;
+            if (!owned && (r.position.x < lo || r.position.x > hi)) continue;
+
+            m_LocalIndex[r.id] = (int)used;
+            m_Records.push_back(&r);
+
+            if (used < agents.size()) agents[used].Reset(r.id, r.position, (AgentType)r.type);
+            else agents.emplace_back(r.id, r.position, (AgentType)r.type);
+            Agent& a = agents[used++];
+            a.prevPosition = r.prevPosition;
+            a.isFixed = r.isFixed != 0;
+            a.isGhost = !owned;
+            hasInactive |= a.isFixed || a.isGhost;
+            // Ghosts keep the owner's full list so maxBonds checks stay correct
+            if (a.isGhost) a.connectedAgentIDs.assign(r.bondIds, r.bondIds + r.bondCount);
+        }
+    }
+
+    agents.erase(agents.begin() + used, agents.end());
+    engine.m_HasInactiveAgents = hasInactive;
+    engine.m_Pool.Reindex(agents);
+
+    // Bonds: the record of the lower ID is authoritative (rest length and existence). Two workers can
+    // both bond the same agent in one step, once as owned and once as a ghost; bonds past the species
+    // limit are dropped here, so the limit holds again from the next step on.
+    m_BondCount.assign(used, 0);
+    for (size_t i = 0; i < m_Records.size(); ++i) {
+        const AgentRecord& r = *m_Records[i];
+        for (int k = 0; k < r.bondCount; ++k) {
+            int partner = r.bondIds[k];
+            if (partner <= r.id || m_LocalIndex[partner] < 0) continue;
+            int j = m_LocalIndex[partner];
+            if (m_BondCount[i] >= agents[i].MaxBonds() || m_BondCount[j] >= agents[j].MaxBonds()) continue;
+            m_BondCount[i]++;
+            m_BondCount[j]++;
+
+            Spring spring;
+            spring.a = &agents[i];
+            spring.b = &agents[j];
+            spring.restLength = r.bondRest[k];
+            const Interactions::Pair& pair = Interactions::Between(spring.a->type, spring.b->type);
+            spring.springConstant = engine.m_SpringK * pair.springScale;
+            spring.breakingThreshold = engine.m_BreakingThreshold * pair.breakScale;
+            engine.m_Springs.push_back(spring);
+        }
+    }
+
+    for (const auto& spring : engine.m_Springs) {
+        if (!spring.a->isGhost) spring.a->connectedAgentIDs.push_back(spring.b->id);
+        if (!spring.b->isGhost) spring.b->connectedAgentIDs.push_back(spring.a->id);
+    }
+
+    // A partner missing from an owned agent's view was stretched past the halo: the bond is gone
+    if (index >= 0) {
+        for (size_t i = 0; i < m_Records.size(); ++i) {
+            const AgentRecord& r = *m_Records[i];
+            if (agents[i].isGhost) continue;
+            for (int k = 0; k < r.bondCount; ++k) {
+                if (r.bondIds[k] > r.id && m_LocalIndex[r.bondIds[k]] < 0) engine.m_BrokenBondsTotal++;
+            }
+        }
+    }
+}
+
+void DomainDecomposition::Export(const SimulationEngine& engine, Header* header, int index) {
+    const auto& agents = engine.m_Agents;
+    int n = header->workerCount;
+    if (index >= 0) header->counts[index] = 0;
+    else std::fill(header->counts, header->counts + n, 0);
+
+    m_RecordOf.assign(agents.size(), nullptr);
+
+    for (size_t i = 0; i < agents.size(); ++i) {
+        const Agent& a = agents[i];
+        if (a.isGhost) continue;
+
+        int slot = index >= 0 ? index : SlabOf(a.position.x, header->containerRadius, header->slabWidth, n);
+        AgentRecord& r = Slot(header, header->capacity, slot)[header->counts[slot]++];
+        r.id = a.id;
+        r.type = (int)a.type;
+        r.isFixed = a.isFixed ? 1 : 0;
+        r.position = a.position;
+        r.prevPosition = a.prevPosition;
+        r.bondCount = std::min((int)a.connectedAgentIDs.size(), (int)MAX_BONDS);
+        for (int k = 0; k < r.bondCount; ++k) {
+            r.bondIds[k] = a.connectedAgentIDs[k];
+            r.bondRest[k] = 0.0f;
+        }
+        m_RecordOf[i] = &r;
+    }
+
+    for (const auto& spring : engine.m_Springs) {
+        const Agent* ends[2] = { spring.a, spring.b };
+        for (int e = 0; e < 2; ++e) {
+            AgentRecord* r = m_RecordOf[ends[e] - agents.data()];
+            if (!r) continue;
+            int partner = ends[1 - e]->id;
+            for (int k = 0; k < r->bondCount; ++k) {
+                if (r->bondIds[k] == partner) { r->bondRest[k] = spring.restLength; break; }
+            }
+        }
+    }
+
+    if (index >= 0) header->brokenBonds[index] = engine.m_BrokenBondsTotal;
+}
+
+bool DomainDecomposition::Start(SimulationEngine& engine, int workerCount) {
+    Stop();
+    if (const char* reason = Unsupported(engine)) {
+        std::cerr << "Domain decomposition does not support " << reason << std::endl;
+        return false;
+    }
+    std::string workerPath = m_WorkerPath.empty() ? DefaultWorkerPath() : m_WorkerPath;
+    if (access(workerPath.c_str(), X_OK) != 0) {
+        std::cerr << "Domain worker program " << workerPath << " not found" << std::endl;
+        return false;
+    }
+    workerCount = std::min(std::max(workerCount, 1), (int)MAX_WORKERS);
+
+    int capacity = std::max(1, (int)engine.m_Agents.size()); // Worst case: everyone migrates into one slab
+    int totalAgents = 0;
+    for (const auto& a : engine.m_Agents) totalAgents = std::max(totalAgents, a.id + 1);
+
+    m_MappedSize = HeaderBytes() + (size_t)workerCount * capacity * sizeof(AgentRecord);
+    std::snprintf(m_ShmName, sizeof(m_ShmName), "/chlebek_%d", (int)getpid());
+
+    int fd = shm_open(m_ShmName, O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (fd < 0 || ftruncate(fd, (off_t)m_MappedSize) != 0) {
+        std::cerr << "Failed to create shared memory " << m_ShmName << std::endl;
+        if (fd >= 0) { close(fd); shm_unlink(m_ShmName); }
+        return false;
+    }
+    void* mem = mmap(nullptr, m_MappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        std::cerr << "Failed to map shared memory " << m_ShmName << std::endl;
+        shm_unlink(m_ShmName);
+        return false;
+    }
+    static_assert(sizeof(Header) <= 4096, "Header must fit in front of the record slots");
+
+    m_Header = (Header*)mem;
+    std::memset(m_Header, 0, sizeof(Header));
+    InitBarrier(m_Header->barrier, workerCount + 1);
+
+    m_Header->coordinator = (int)getpid();
+    m_Header->workerCount = workerCount;
+    m_Header->capacity = capacity;
+    m_Header->totalAgents = totalAgents;
+    m_Header->containerRadius = engine.m_ContainerRadius;
+    m_Header->floorY = engine.m_FloorY;
+    m_Header->containerHeight = engine.m_ContainerHeight;
+    m_Header->slabWidth = 2.0f * engine.m_ContainerRadius / workerCount;
+    m_Header->haloWidth = HaloWidth(engine);
+    WriteParams(engine, m_Header->params);
+    Export(engine, m_Header, -1);
+    m_BrokenBase = engine.m_BrokenBondsTotal;
+
+    // Workers are fresh processes (forking would inherit a broken OpenMP runtime)
+    for (int w = 0; w < workerCount; ++w) {
+        char indexArg[16];
+        std::snprintf(indexArg, sizeof(indexArg), "%d", w);
+        char* argv[] = { &workerPath[0], m_ShmName, indexArg, nullptr };
+
+        pid_t pid;
+        if (posix_spawn(&pid, workerPath.c_str(), nullptr, nullptr, argv, environ) != 0) {
+            std::cerr << "Failed to spawn domain worker " << w << std::endl;
+            Abort();
+            return false;
+        }
+        m_Workers.push_back(pid);
+    }
+    return true;
+}
+
+void DomainDecomposition::Stop() {
+    if (!m_Header) return;
+
+    m_Header->quit = 1;
+    if (!Rendezvous()) return;
+    for (int pid : m_Workers) waitpid(pid, nullptr, 0);
+    m_Workers.clear();
+    DestroyBarrier(m_Header->barrier);
+    Release();
+}
+
+void DomainDecomposition::Abort() {
+    for (int pid : m_Workers) kill(pid, SIGKILL);
+    for (int pid : m_Workers) waitpid(pid, nullptr, 0);
+    m_Workers.clear();
+    Release();
+}
+
+// Unmaps without destroying the barrier: after Abort, pthread_cond_destroy would wait for waiters that
+// a killed worker never confirms. Stop destroys it once every worker has left cleanly.
+void DomainDecomposition::Release() {
+    munmap(m_Header, m_MappedSize);
+    shm_unlink(m_ShmName);
+    m_Header = nullptr;
+}
+
+bool DomainDecomposition::WorkersAlive() {
+    // Exited workers are reaped here, so Abort never signals a PID that may have been reused
+    bool alive = true;
+    for (auto it = m_Workers.begin(); it != m_Workers.end(); ) {
+        if (waitpid(*it, nullptr, WNOHANG) != 0) {
+            it = m_Workers.erase(it);
+            alive = false;
+        } else {
+            ++it;
+        }
+    }
+    return alive;
+}
+
+bool DomainDecomposition::Rendezvous() {
+    if (WaitBarrier(m_Header->barrier, [this] { return WorkersAlive(); })) return true;
+    std::cerr << "A domain worker exited, stopping multi-process mode" << std::endl;
+    Abort();
+    return false;
+}
+
+void DomainDecomposition::Step(SimulationEngine& engine, float dt) {
+    if (!m_Header) return;
+    if (const char* reason = Unsupported(engine)) {
+        std::cerr << "Domain decomposition does not support " << reason << ", stopping multi-process mode" << std::endl;
+        Stop();
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    // Added or removed agents change IDs and slot sizes: apply them here and restart the workers from this state
+    engine.m_StepDt = dt;
+    if (engine.UpdatePopulation() && !Start(engine, GetWorkerCount())) return;
+
+    WriteParams(engine, m_Header->params);
+    m_Header->haloWidth = HaloWidth(engine);
+    m_Header->dt = dt;
+    m_Header->time = engine.m_Time;
+
+    if (!Rendezvous()) return; // 1. Go
+    if (!Rendezvous()) return; // 2. Halo read
+    if (!Rendezvous()) return; // 3. Slots written
+
+    Import(engine, m_Header, -1);
+
+    int broken = m_BrokenBase;
+    for (int w = 0; w < m_Header->workerCount; ++w) broken += m_Header->brokenBonds[w];
+    engine.m_BrokenBondsTotal = broken;
+
+    // Keep the coordinator's mixer in sync for rendering
+    engine.m_Time += dt;
+    engine.m_Mixer.Update(engine.m_Time);
+    engine.m_Tool.SetTransform(engine.m_Mixer.position, engine.m_Mixer.angle);
+
+    // Only the whole step is timed here, the phases run inside the workers
+    engine.m_Timings = StepTimings();
+    engine.m_Timings.ms[PHASE_TOTAL] = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (engine.m_Telemetry.publisher) engine.PublishTelemetry();
+}
+
+int DomainDecomposition::RunWorker(const char* shmName, int index) {
+    int fd = shm_open(shmName, O_RDWR, 0600);
+    if (fd < 0) {
+        std::cerr << "Worker " << index << ": failed to open " << shmName << std::endl;
+        return -1;
+    }
+    struct stat st;
+    fstat(fd, &st);
+    void* mem = mmap(nullptr, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) return -1;
+    Header* header = (Header*)mem;
+
+    SimulationEngine engine;
+    engine.m_ContainerRadius = header->containerRadius;
+    engine.m_FloorY = header->floorY;
+    engine.m_ContainerHeight = header->containerHeight;
+    ReadParams(header->params, engine);
+    engine.RebuildColliders();
+    engine.m_RemoveEscapedAgents = false;   // The coordinator owns the population
+    engine.m_AllowSleep = false;            // Halo copies are re-imported every step and would never settle
+    engine.m_Agents.reserve(header->capacity);
+    engine.m_Springs.reserve(header->capacity * MAX_BONDS / 2);
+
+    DomainDecomposition slab;               // Import/Export scratch of this worker
+    int tool = header->params.mixerTool;
+    // A coordinator that died leaves the worker orphaned (re-parented), which ends it too
+    int coordinator = header->coordinator;
+    auto coordinatorAlive = [coordinator] { return (int)getppid() == coordinator; };
+
+    while (true) {
+        if (!WaitBarrier(header->barrier, coordinatorAlive)) break; // 1. Step requested
+        if (header->quit) break;
+
+        ReadParams(header->params, engine);
+        if (header->params.mixerTool != tool) {
+            tool = header->params.mixerTool;
+            engine.RebuildColliders();
+        }
+        slab.Import(engine, header, index);
+        // 2. Everyone has read the slots, safe to overwrite ours
+        if (!WaitBarrier(header->barrier, coordinatorAlive)) break;
+
+        engine.m_Time = header->time;
+        engine.Update(header->dt);
+        slab.Export(engine, header, index);
+        if (!WaitBarrier(header->barrier, coordinatorAlive)) break; // 3. Our slot is complete
+    }
+
+    munmap(mem, (size_t)st.st_size);
+    if (!coordinatorAlive()) shm_unlink(shmName); // Nobody else is left to remove it
+    return 0;
+}
+
+#endif
@@ -0,0 +1,94 @@
+#pragma once
+#include "SimulationEngine.h"
+#include <string>
+#include <vector>
+
+// Multi-process mode (POSIX only).
+// The container is cut into slabs along X, each owned by a worker process with its own
+// SimulationEngine and OpenMP team. Every step the workers export their owned agents to
+// shared memory; neighbours read them back as ghosts (halo), agents that crossed a slab
+// boundary migrate to their new owner, and bonds across the boundary are rebuilt from the
+// exported bond lists. Workers run as a separate program (tools/domain_worker.cpp), so any
+// host of the library can use this mode as long as it ships that program.
+class DomainDecomposition {
+public:
+    static const int MAX_WORKERS = 64;
+    static const int MAX_BONDS = Interactions::MaxBonds();
+
+    std::string m_WorkerPath;           // Worker program; empty = glutensim-worker next to this one
+
+    ~DomainDecomposition() { Stop(); }
+
+    // Spawns the workers and hands them the current state of 'engine'; false for scenarios the
+    // workers cannot reproduce (periodic box, proofing field)
+    bool Start(SimulationEngine& engine, int workerCount);
+    void Stop();
+    bool IsRunning() const { return m_Header != nullptr; }
+    int GetWorkerCount() const { return (int)m_Workers.size(); }
+
+    // Steps all workers once, then gathers the agents and bonds back into 'engine' (for rendering/analytics).
+    // If a worker process died, or the engine switched to an unsupported scenario, the domain is
+    // stopped and 'engine' keeps the last gathered state.
+    void Step(SimulationEngine& engine, float dt);
+
+    // Entry point of a worker process (see tools/domain_worker.cpp)
+    static int RunWorker(const char* shmName, int index);
+
+    struct AgentRecord {
+        int id;
+        int type;
+        int isFixed;
+        int bondCount;
+        glm::vec3 position;
+        glm::vec3 prevPosition;
+        int bondIds[MAX_BONDS];
+        float bondRest[MAX_BONDS];
+    };
+
+    // Tunables mirrored from the coordinating engine every step
+    struct Params {
+        int gravityMode;
+        int mixerTool;
+        float damping;
+        float springK, repulsionK, collisionRadius;
+        int contactLaw;
+        float adhesion, adhesionRange;
+        float staticFriction, dynamicFriction;
+        float bondDistance, breakingThreshold, minSpringLength;
+        float springExpansionRate, maxSpringLength;
+        float temperature, bondProbability, centralForceK;
+        float mixerSpeed, mixerSpin;
+    };
+
+private:
+    struct Header;                      // Shared-memory layout, defined in the .cpp
+
+    Header* m_Header = nullptr;
+    size_t m_MappedSize = 0;
+    char m_ShmName[64] = {};
+    std::vector<int> m_Workers;         // Worker PIDs
+    int m_BrokenBase = 0;               // Broken bonds counted before Start
+
+    // Import/Export scratch, kept for its capacity
+    std::vector<int> m_LocalIndex;      // Agent ID -> index in the imported engine
+    std::vector<const AgentRecord*> m_Records;      // Imported agent -> its record
+    std::vector<AgentRecord*> m_RecordOf;           // Exported agent -> its record
+    std::vector<int> m_BondCount;                   // Imported agent -> bonds rebuilt so far
+
+    static void WriteParams(const SimulationEngine& engine, Params& params);
+    static void ReadParams(const Params& params, SimulationEngine& engine);
+    static float HaloWidth(const SimulationEngine& engine);
+    // What the workers cannot reproduce from Params, or nullptr
+    static const char* Unsupported(const SimulationEngine& engine);
+
+    // Waits for the workers at the next step barrier; false (and the domain stopped) if one of them died
+    bool Rendezvous();
+    bool WorkersAlive();
+    // Kills the workers instead of asking them to quit, for when they cannot all reach the barrier
+    void Abort();
+    void Release();
+
+    // index >= 0: owned agents of that slab plus its halo; index < 0: every agent (gather/scatter)
+    void Import(SimulationEngine& engine, Header* header, int index);
+    void Export(const SimulationEngine& engine, Header* header, int index);
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+// Agent species and how every pair of them interacts, fixed at compile time.
+// Adding a species = one enum entry + one SPECIES row + its bond rule; the kernels only do table lookups.
+enum AgentType : unsigned char { GLUTENIN, GLIADIN, STARCH, AGENT_TYPE_COUNT };
+
+namespace Interactions {
+
+    struct Species {
+        float mass;
+        float invMass;
+        float radius;       // Contact radius (container, mixer and agent-agent repulsion)
+        int maxBonds;
+        float color[3];     // Render color
+    };
+
+    // Everything except canBond must be symmetric: a spring may be rebuilt with its ends swapped
+    struct Pair {
+        bool canBond;           // First type may start a bond with the second
+        float springScale;      // Bond stiffness = m_SpringK * springScale
+        float breakScale;       // Bond breaking length = m_BreakingThreshold * breakScale
+        float contactDistance;  // Repulsion starts below this centre distance
+        float repulsionScale;   // Contact stiffness = m_RepulsionK * repulsionScale
+        float adhesionScale;    // Attraction just outside contact = m_Adhesion * adhesionScale (see ContactTable.h)
+    };
+
+    constexpr Species SPECIES[AGENT_TYPE_COUNT] = {
+        /* GLUTENIN */ { 2.0f, 1.0f / 2.0f, 0.03f, 4, { 1.0f, 0.6f, 0.0f } },   // Orange
+        /* GLIADIN  */ { 1.0f, 1.0f / 1.0f, 0.02f, 2, { 1.0f, 0.9f, 0.2f } },   // Yellow
+        /* STARCH   */ { 10.0f, 1.0f / 10.0f, 0.05f, 0, { 0.9f, 0.9f, 0.9f } }, // White
+    };
+
+    // Only glutenin starts bonds: with gliadin (a gliadin-glutenin pair is seen from the glutenin side)
+    // and with other glutenin (the disulfide network)
+    constexpr bool BondRule(AgentType a, AgentType b) {
+        return a == GLUTENIN && (b == GLIADIN || b == GLUTENIN);
+    }
+
+    // Starch granules stick to whatever they touch
+    constexpr float AdhesionRule(AgentType a, AgentType b) {
+        return a == STARCH || b == STARCH ? 1.0f : 0.0f;
+    }
+
+    constexpr Pair MakePair(AgentType a, AgentType b) {
+        return { BondRule(a, b), 1.0f, 1.0f, SPECIES[a].radius + SPECIES[b].radius, 1.0f, AdhesionRule(a, b) };
+    }
+
+    struct PairTable {
+        Pair pairs[AGENT_TYPE_COUNT][AGENT_TYPE_COUNT] = {};
+
+        constexpr PairTable() {
+            for (int a = 0; a < AGENT_TYPE_COUNT; ++a)
+                for (int b = 0; b < AGENT_TYPE_COUNT; ++b)
+                    pairs[a][b] = MakePair((AgentType)a, (AgentType)b);
+        }
+    };
+
+    inline constexpr PairTable PAIRS{};
+
+    constexpr const Species& Of(AgentType t) { return SPECIES[t]; }
+    constexpr const Pair& Between(AgentType a, AgentType b) { return PAIRS.pairs[a][b]; }
+
+    constexpr int MaxBonds() {
+        int result = 0;
+        for (const auto& s : SPECIES) result = s.maxBonds > result ? s.maxBonds : result;
+        return result;
+    }
+
+    constexpr float MaxContactDistance() {
+        float result = 0.0f;
+        for (int a = 0; a < AGENT_TYPE_COUNT; ++a)
+            for (int b = 0; b < AGENT_TYPE_COUNT; ++b)
+                result = PAIRS.pairs[a][b].contactDistance > result ? PAIRS.pairs[a][b].contactDistance : result;
+        return result;
+    }
+}
@@ -6,7 +6,9 @@ struct Mixer {
     glm::vec3 position;
     float radius;
     float speed;
-    
+    float spin = 2.0f;   // Rotation of the tool around its own axis (rad/s)
+    float angle = 0.0f;
+
     // Lissajous parameters
     float A = 0.5f;
     float B = 0.5f;
@@ -19,6 +21,7 @@ struct Mixer {
         float t = time * speed;
         position.x = A * std::sin(a * t);
         position.z = B * std::cos(b * t);
-        // Y is irrelevant for an infinite vertical rod
+        // Y stays at 0, the tool geometry spans the whole container height
+        angle = spin * t;
     }
 };
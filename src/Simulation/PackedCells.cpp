@@ -0,0 +1,199 @@
+#include "PackedCells.h"
+#include <algorithm>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+    const float MIN_DISTANCE2 = 1e-8f;      // Coincident pairs (and the agent itself) push nothing
+}
+
+const char* PackedCells::InstructionSet() {
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX2__)
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
+
+void PackedCells::Build(const std::vector<Agent>& agents, const SpatialGrid& grid, const ContactTable& table) {
+    for (int a = 0; a < AGENT_TYPE_COUNT; ++a) {
+        for (int b = 0; b < AGENT_TYPE_COUNT; ++b) {
+            m_Cutoff2[a][b] = table.Cutoff2((AgentType)a, (AgentType)b);
+            m_InvStep[a][b] = table.InvStep((AgentType)a, (AgentType)b);
+        }
+    }
+    // Only the small per-pair constants are copied; the samples are read in place, the table rebuilds
+    // them when its settings change, not per step
+    m_Samples = table.Row((AgentType)0);
+
+    // Counting sort by cell; agents outside the grid are not packed (the grid does not list them either)
+    m_Dimensions = grid.GetDimensions();
+    m_Periodic = grid.IsPeriodic();
+    m_Box = grid.GetPeriodicBox();
+    int cells = m_Dimensions.x * m_Dimensions.y * m_Dimensions.z;
+    int count = (int)agents.size();
+    m_Start.assign(cells + 1, 0);
+    for (int i = 0; i < count; ++i) {
+        int cell = grid.GetAgentCell(i);
+        if (cell >= 0) m_Start[cell + 1]++;
+    }
+    for (int c = 0; c < cells; ++c) m_Start[c + 1] += m_Start[c];
+
+    int packed = m_Start[cells];
+    m_X.resize(packed + WIDTH);
+    m_Y.resize(packed + WIDTH);
+    m_Z.resize(packed + WIDTH);
+    m_Type.resize(packed + WIDTH);
+    for (int i = 0; i < count; ++i) {
+        int cell = grid.GetAgentCell(i);
+        if (cell < 0) continue;
+        // m_Start[cell] serves as the fill cursor and ends up at the start of the next cell
+        int slot = m_Start[cell]++;
+        m_X[slot] = agents[i].position.x;
+        m_Y[slot] = agents[i].position.y;
+        m_Z[slot] = agents[i].position.z;
+        m_Type[slot] = agents[i].type;
+    }
+    for (int c = cells; c > 0; --c) m_Start[c] = m_Start[c - 1];
+    m_Start[0] = 0;
+    std::fill(m_Type.begin() + packed, m_Type.end(), 0);
+}
+
+glm::vec3 PackedCells::Repulsion(const glm::ivec3& cell, const glm::vec3& position, AgentType type) const {
+    glm::vec3 force(0.0f);
+    if (m_Periodic) {
+        // Each run is compared against the agent moved into the frame of that run's images
+        m_Box.ForEachNeighborRun(position, [&](int x0, int x1, int y, int z, const glm::vec3& shift) {
+            int row = (y + z * m_Dimensions.y) * m_Dimensions.x;
+            int begin = m_Start[row + x0];
+            int end = m_Start[row + x1 + 1];
+            if (begin < end) Accumulate(begin, end, position - shift, type, force);
+        });
+        return force;
+    }
+    int x0 = std::max(cell.x - 1, 0);
+    int x1 = std::min(cell.x + 1, m_Dimensions.x - 1);
+    if (x0 > x1) return force;
+    for (int z = std::max(cell.z - 1, 0); z <= std::min(cell.z + 1, m_Dimensions.z - 1); ++z) {
+        for (int y = std::max(cell.y - 1, 0); y <= std::min(cell.y + 1, m_Dimensions.y - 1); ++y) {
+            int row = (y + z * m_Dimensions.y) * m_Dimensions.x;
+            int begin = m_Start[row + x0];
+            int end = m_Start[row + x1 + 1];
+            if (begin < end) Accumulate(begin, end, position, type, force);
+        }
+    }
+    return force;
+}
+
+void PackedCells::Accumulate(int begin, int end, const glm::vec3& position, AgentType type, glm::vec3& force) const {
+    const float* x = m_X.data();
+    const float* y = m_Y.data();
+    const float* z = m_Z.data();
+    const int* types = m_Type.data();
+    const float* cutoffRow = m_Cutoff2[type];
+    const float* invStepRow = m_InvStep[type];
+    const float* table = m_Samples + type * AGENT_TYPE_COUNT * ContactTable::SAMPLES;
+    const int last = ContactTable::SAMPLES - 2;
+
+    // Per lane: d = agent - candidate, interacting if 1e-8 < |d|^2 < cutoff^2, force += d * F(|d|) / |d|
+    // with F / |d| interpolated from the candidate type's table at x = |d|^2 / step (gathered at
+    // candidate type * SAMPLES + floor(x) and the sample after it). Lanes past 'end' are masked off.
+#if defined(__AVX512F__)
+    const __m512 px = _mm512_set1_ps(position.x);
+    const __m512 py = _mm512_set1_ps(position.y);
+    const __m512 pz = _mm512_set1_ps(position.z);
+    const __m512 cutoffLookup = _mm512_loadu_ps(cutoffRow);
+    const __m512 invStepLookup = _mm512_loadu_ps(invStepRow);
+    const __m512 minDistance2 = _mm512_set1_ps(MIN_DISTANCE2);
+    const __m512i lastSample = _mm512_set1_epi32(last);
+    const __m512i samples = _mm512_set1_epi32(ContactTable::SAMPLES);
+    __m512 fx = _mm512_setzero_ps();
+    __m512 fy = _mm512_setzero_ps();
+    __m512 fz = _mm512_setzero_ps();
+    for (int k = begin; k < end; k += WIDTH) {
+        __mmask16 valid = end - k >= WIDTH ? (__mmask16)0xffff : (__mmask16)((1u << (end - k)) - 1);
+        __m512 dx = _mm512_sub_ps(px, _mm512_loadu_ps(x + k));
+        __m512 dy = _mm512_sub_ps(py, _mm512_loadu_ps(y + k));
+        __m512 dz = _mm512_sub_ps(pz, _mm512_loadu_ps(z + k));
+        __m512 d2 = _mm512_fmadd_ps(dx, dx, _mm512_fmadd_ps(dy, dy, _mm512_mul_ps(dz, dz)));
+        __m512i lane = _mm512_loadu_si512(types + k);
+        __mmask16 touching = valid & _mm512_cmp_ps_mask(d2, _mm512_permutexvar_ps(lane, cutoffLookup), _CMP_LT_OQ) &
+                             _mm512_cmp_ps_mask(d2, minDistance2, _CMP_GT_OQ);
+        if (!touching) continue;
+
+        // Lanes out of range may hold any x; the masked gathers never read for them
+        __m512 sample = _mm512_mul_ps(d2, _mm512_permutexvar_ps(lane, invStepLookup));
+        __m512i i = _mm512_min_epi32(_mm512_cvttps_epi32(sample), lastSample);
+        __m512 frac = _mm512_sub_ps(sample, _mm512_cvtepi32_ps(i));
+        __m512i index = _mm512_add_epi32(_mm512_mullo_epi32(lane, samples), i);
+        __m512 t0 = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), touching, index, table, 4);
+        __m512 t1 = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), touching, _mm512_add_epi32(index, _mm512_set1_epi32(1)), table, 4);
+        __m512 scale = _mm512_fmadd_ps(frac, _mm512_sub_ps(t1, t0), t0);
+        fx = _mm512_fmadd_ps(dx, scale, fx);
+        fy = _mm512_fmadd_ps(dy, scale, fy);
+        fz = _mm512_fmadd_ps(dz, scale, fz);
+    }
+    force += glm::vec3(_mm512_reduce_add_ps(fx), _mm512_reduce_add_ps(fy), _mm512_reduce_add_ps(fz));
+
+#elif defined(__AVX2__)
+    const __m256 px = _mm256_set1_ps(position.x);
+    const __m256 py = _mm256_set1_ps(position.y);
+    const __m256 pz = _mm256_set1_ps(position.z);
+    const __m256 cutoffLookup = _mm256_loadu_ps(cutoffRow);
+    const __m256 invStepLookup = _mm256_loadu_ps(invStepRow);
+    const __m256 minDistance2 = _mm256_set1_ps(MIN_DISTANCE2);
+    const __m256i lastSample = _mm256_set1_epi32(last);
+    const __m256i samples = _mm256_set1_epi32(ContactTable::SAMPLES);
+    const __m256i laneIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256 fx = _mm256_setzero_ps();
+    __m256 fy = _mm256_setzero_ps();
+    __m256 fz = _mm256_setzero_ps();
+    for (int k = begin; k < end; k += WIDTH) {
+        __m256 valid = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(end - k), laneIndex));
+        __m256 dx = _mm256_sub_ps(px, _mm256_loadu_ps(x + k));
+        __m256 dy = _mm256_sub_ps(py, _mm256_loadu_ps(y + k));
+        __m256 dz = _mm256_sub_ps(pz, _mm256_loadu_ps(z + k));
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dz, dz)));
+        __m256i lane = _mm256_loadu_si256((const __m256i*)(types + k));
+        __m256 touching = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(d2, _mm256_permutevar8x32_ps(cutoffLookup, lane), _CMP_LT_OQ),
+                                                             _mm256_cmp_ps(d2, minDistance2, _CMP_GT_OQ)));
+        if (_mm256_movemask_ps(touching) == 0) continue;
+
+        // Lanes out of range may hold any x; the masked gathers never read for them and leave zero
+        __m256 sample = _mm256_mul_ps(d2, _mm256_permutevar8x32_ps(invStepLookup, lane));
+        __m256i i = _mm256_min_epi32(_mm256_cvttps_epi32(sample), lastSample);
+        __m256 frac = _mm256_sub_ps(sample, _mm256_cvtepi32_ps(i));
+        __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(lane, samples), i);
+        __m256 t0 = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), table, index, touching, 4);
+        __m256 t1 = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), table, _mm256_add_epi32(index, _mm256_set1_epi32(1)), touching, 4);
+        __m256 scale = _mm256_add_ps(t0, _mm256_mul_ps(frac, _mm256_sub_ps(t1, t0)));
+        fx = _mm256_add_ps(fx, _mm256_mul_ps(dx, scale));
+        fy = _mm256_add_ps(fy, _mm256_mul_ps(dy, scale));
+        fz = _mm256_add_ps(fz, _mm256_mul_ps(dz, scale));
+    }
+    auto sum = [](__m256 v) {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_movehdup_ps(s));
+        return _mm_cvtss_f32(s);
+    };
+    force += glm::vec3(sum(fx), sum(fy), sum(fz));
+
+#else
+    for (int k = begin; k < end; ++k) {
+        glm::vec3 d(position.x - x[k], position.y - y[k], position.z - z[k]);
+        float d2 = glm::dot(d, d);
+        int candidate = types[k];
+        if (d2 < cutoffRow[candidate] && d2 > MIN_DISTANCE2) {
+            float sample = d2 * invStepRow[candidate];
+            int i = std::min((int)sample, last);
+            const float* t = table + candidate * ContactTable::SAMPLES + i;
+            force += d * (t[0] + (sample - i) * (t[1] - t[0]));
+        }
+    }
+#endif
+}
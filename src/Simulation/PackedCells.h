@@ -0,0 +1,51 @@
+#pragma once
+#include "Agent.h"
+#include "SpatialGrid.h"
+#include "ContactTable.h"
+#include <vector>
+
+// Agent positions and types packed cell by cell in structure-of-arrays form, for a vectorized contact kernel.
+// Rebuilt once per step from the grid's cell assignment (a counting sort, so agents in a cell keep index
+// order). Cells x-1..x+1 of one grid row are adjacent in the packing, so the 3x3x3 neighbourhood of an
+// agent is nine contiguous runs that Repulsion() walks SIMD-width lanes at a time: AVX-512 or AVX2 when
+// the compiler targets them (-march=native in release builds), a scalar loop otherwise.
+class PackedCells {
+public:
+#if defined(__AVX512F__)
+    static constexpr int WIDTH = 16;
+#elif defined(__AVX2__)
+    static constexpr int WIDTH = 8;
+#else
+    static constexpr int WIDTH = 1;
+#endif
+    static const char* InstructionSet();
+
+    // The grid must be up to date for these agents. The force law is read from the contact table, which must
+    // stay alive and unchanged until the next Build
+    void Build(const std::vector<Agent>& agents, const SpatialGrid& grid, const ContactTable& table);
+
+    // Sum of the contact forces (repulsion and adhesion, as tabulated) on an agent of 'type' at 'position'
+    // (in grid cell 'cell') from every packed agent in the neighbouring cells. The agent itself drops out like any coincident pair
+    // (distance below 1e-4). With a periodic grid the walk wraps and 'cell' is not used.
+    glm::vec3 Repulsion(const glm::ivec3& cell, const glm::vec3& position, AgentType type) const;
+
+private:
+    // Pair parameters are looked up per lane with a register permute, one row per agent type
+    static constexpr int ROW = WIDTH > 8 ? WIDTH : 8;
+    static_assert(AGENT_TYPE_COUNT <= ROW, "Agent types must fit in one register");
+
+    glm::ivec3 m_Dimensions = glm::ivec3(0);
+    bool m_Periodic = false;            // Copied from the grid with its box
+    PeriodicBox m_Box;
+    std::vector<int> m_Start;           // Per cell: first packed slot; one extra entry closes the last cell
+    // Packed agents, followed by WIDTH slots of padding so a full-width load never leaves the arrays
+    std::vector<float> m_X, m_Y, m_Z;
+    std::vector<int> m_Type;
+    // Squared cutoff and inverse sample spacing of [agent type][candidate type], from the contact table
+    float m_Cutoff2[AGENT_TYPE_COUNT][ROW] = {};
+    float m_InvStep[AGENT_TYPE_COUNT][ROW] = {};
+    const float* m_Samples = nullptr;   // The table's F(r) / r samples, [agent type][candidate type][SAMPLES]
+
+    // Contact forces from packed slots [begin, end) accumulated into force
+    void Accumulate(int begin, int end, const glm::vec3& position, AgentType type, glm::vec3& force) const;
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cmath>
+#include <algorithm>
+
+// Triply periodic box for bulk samples, with Lees-Edwards shear in x across the y boundary.
+// The box covers whole spatial grid cells (cells.x * cellSize etc., starting at grid cell firstCell),
+// so the grid and the packed cells keep their layout and only the neighbour walk wraps.
+// The image above the box (y + size.y) is displaced by +shearOffset in x and moves at
+// +shearRate * size.y, the one below the opposite way; the offset grows with time and wraps at size.x.
+struct PeriodicBox {
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 size = glm::vec3(1.0f);
+    glm::ivec3 firstCell = glm::ivec3(0);
+    glm::ivec3 cells = glm::ivec3(3);   // At least 3 per axis, so the 3x3x3 neighbourhood has no repeats
+    float cellSize = 1.0f;
+    float shearRate = 0.0f;             // 1/s, velocity gradient dvx/dy
+    float shearOffset = 0.0f;           // In [0, size.x)
+
+    void AdvanceShear(float dt) {
+        shearOffset = std::fmod(shearOffset + shearRate * size.y * dt, size.x);
+        if (shearOffset < 0.0f) shearOffset += size.x;
+    }
+
+    // Shortest separation a - b over all images of b (valid for distances below half the box)
+    glm::vec3 MinimumImage(glm::vec3 d) const {
+        float ky = std::round(d.y / size.y);
+        d.y -= ky * size.y;
+        d.x -= ky * shearOffset;
+        d.x -= std::round(d.x / size.x) * size.x;
+        d.z -= std::round(d.z / size.z) * size.z;
+        return d;
+    }
+
+    // Moves p back into the box; returns the velocity change per unit of time of the y crossing
+    // (an agent leaving through the top arrives at the bottom in the frame of the lower image)
+    float Wrap(glm::vec3& p) const {
+        float ky = std::floor((p.y - min.y) / size.y);
+        p.y -= ky * size.y;
+        p.x -= ky * shearOffset;
+        p.x -= std::floor((p.x - min.x) / size.x) * size.x;
+        p.z -= std::floor((p.z - min.z) / size.z) * size.z;
+        return -ky * shearRate * size.y;
+    }
+
+    // Streaming velocity of the imposed shear at height y (zero at the box centre)
+    float StreamVelocity(float y) const { return shearRate * (y - (min.y + 0.5f * size.y)); }
+
+    // Visits the 3x3x3 cells around p as runs of consecutive cells along x:
+    // visit(gridX0, gridX1, gridY, gridZ, shift) with grid cell coordinates (inclusive x range) and the
+    // shift that turns the stored positions of those cells into the images next to p.
+    template<typename Visit>
+    void ForEachNeighborRun(const glm::vec3& p, Visit visit) const {
+        int cy = CellAlong(p.y - min.y, cells.y);
+        int cz = CellAlong(p.z - min.z, cells.z);
+        for (int dz = -1; dz <= 1; ++dz) {
+            int z = cz + dz;
+            float sz = 0.0f;
+            if (z < 0) { z += cells.z; sz = -size.z; }
+            else if (z >= cells.z) { z -= cells.z; sz = size.z; }
+            for (int dy = -1; dy <= 1; ++dy) {
+                int y = cy + dy;
+                glm::vec3 shift(0.0f, 0.0f, sz);
+                if (y < 0) { y += cells.y; shift.x = -shearOffset; shift.y = -size.y; }
+                else if (y >= cells.y) { y -= cells.y; shift.x = shearOffset; shift.y = size.y; }
+
+                // Across the y boundary the neighbours sit under p - shift, in a sheared x column
+                float x = p.x - shift.x - min.x;
+                if (x < 0.0f) { x += size.x; shift.x -= size.x; }
+                else if (x >= size.x) { x -= size.x; shift.x += size.x; }
+                int cx = CellAlong(x, cells.x);
+
+                int gy = firstCell.y + y, gz = firstCell.z + z, gx = firstCell.x;
+                if (cx == 0) {
+                    visit(gx, gx + 1, gy, gz, shift);
+                    visit(gx + cells.x - 1, gx + cells.x - 1, gy, gz, shift - glm::vec3(size.x, 0.0f, 0.0f));
+                } else if (cx == cells.x - 1) {
+                    visit(gx + cx - 1, gx + cx, gy, gz, shift);
+                    visit(gx, gx, gy, gz, shift + glm::vec3(size.x, 0.0f, 0.0f));
+                } else {
+                    visit(gx + cx - 1, gx + cx + 1, gy, gz, shift);
+                }
+            }
+        }
+    }
+
+private:
+    int CellAlong(float offset, int count) const {
+        return std::clamp((int)std::floor(offset / cellSize), 0, count - 1);
+    }
+};
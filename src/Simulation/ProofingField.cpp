@@ -0,0 +1,142 @@
+#include "ProofingField.h"
+#include <algorithm>
+#include <cmath>
+
+void ProofingField::Init(float radius, float floorY, float lidY, float temperature, const std::vector<Agent>& agents) {
+    m_Origin = glm::vec3(-radius, floorY, -radius);
+    m_CellSize = glm::vec3(2.0f * radius, lidY - floorY, 2.0f * radius) / (float)N;
+
+    size_t cells = (size_t)P * P * P;
+    m_Temperature.assign(cells, temperature);
+    m_CO2.assign(cells, 0.0f);
+    m_Next.assign(cells, 0.0f);
+    m_Dough.assign(cells, 0.0f);
+    m_Interior.assign(cells, 0.0f);
+
+    // Interior = cell centre inside the cylinder; the padding layer stands for floor, lid and wall
+    for (int z = 1; z <= N; ++z) {
+        for (int y = 1; y <= N; ++y) {
+            for (int x = 1; x <= N; ++x) {
+                glm::vec3 centre = m_Origin + (glm::vec3(x, y, z) - 0.5f) * m_CellSize;
+                if (centre.x * centre.x + centre.z * centre.z < radius * radius) m_Interior[Index(x, y, z)] = 1.0f;
+            }
+        }
+    }
+
+    // Calibrate: the mean agent count of the occupied cells is a full cell
+    m_CellCapacity = 1.0f;
+    Deposit(agents);
+    float total = 0.0f;
+    int occupied = 0;
+    for (size_t i = 0; i < cells; ++i) {
+        if (m_Dough[i] > 0.0f) {
+            total += m_Dough[i];
+            occupied++;
+        }
+    }
+    m_CellCapacity = occupied > 0 ? std::max(1.0f, total / occupied) : 1.0f;
+    Deposit(agents);
+}
+
+int ProofingField::CellOf(const glm::vec3& p) const {
+    // max(0, v) first so a NaN position lands in a valid cell
+    glm::vec3 g = (p - m_Origin) / m_CellSize;
+    int x = (int)std::min(std::max(0.0f, g.x), N - 1.0f);
+    int y = (int)std::min(std::max(0.0f, g.y), N - 1.0f);
+    int z = (int)std::min(std::max(0.0f, g.z), N - 1.0f);
+    return Index(x + 1, y + 1, z + 1);
+}
+
+void ProofingField::Deposit(const std::vector<Agent>& agents) {
+    std::fill(m_Dough.begin(), m_Dough.end(), 0.0f);
+    for (const auto& a : agents) m_Dough[CellOf(a.position)] += 1.0f;
+    float inv = 1.0f / m_CellCapacity;
+    for (size_t i = 0; i < m_Dough.size(); ++i) m_Dough[i] = std::min(1.0f, m_Dough[i] * inv) * m_Interior[i];
+}
+
+void ProofingField::Update(const std::vector<Agent>& agents, float dt) {
+    if (m_Temperature.empty() || dt <= 0.0f) return;
+    Deposit(agents);
+
+    // Explicit diffusion is stable for dt <= h^2 / (6 D); keep a margin and sub-step
+    float h = std::min({ m_CellSize.x, m_CellSize.y, m_CellSize.z });
+    float maxDt = 0.9f * h * h / (6.0f * std::max({ m_HeatDiffusivity, m_CO2Diffusivity, 1e-9f }));
+    int substeps = std::max(1, (int)std::ceil(dt / maxDt));
+    float subDt = dt / substeps;
+
+    const int cells = P * P * P;
+    float* T = m_Temperature.data();
+    float* C = m_CO2.data();
+    const float* dough = m_Dough.data();
+    for (int s = 0; s < substeps; ++s) {
+        Diffuse(m_Temperature, m_HeatDiffusivity, subDt, m_AmbientTemperature, false);
+        Diffuse(m_CO2, m_CO2Diffusivity, subDt, 0.0f, true);
+
+        // Sources and sinks, cell-local and branch-free
+        #pragma omp simd
+        for (int i = 0; i < cells; ++i) {
+            float t = dough[i] > 0.0f ? std::min(T[i], m_MaxDoughTemperature) : T[i];
+            T[i] = t;
+            float u = (t - m_YeastOptimum) * (1.0f / 20.0f);
+            float activity = std::max(0.0f, 1.0f - u * u);
+            // Production saturates as the dough fills with gas (c = 1), escape where there is no dough
+            float production = m_YeastRate * activity * dough[i] * std::max(0.0f, 1.0f - C[i]);
+            float escape = m_CO2Escape * (1.0f - dough[i]) * C[i];
+            C[i] = std::max(0.0f, C[i] + subDt * (production - escape));
+        }
+    }
+
+    float sumT = 0.0f, sumC = 0.0f, sumW = 0.0f;
+    for (int i = 0; i < cells; ++i) {
+        sumT += dough[i] * T[i];
+        sumC += dough[i] * C[i];
+        sumW += dough[i];
+    }
+    m_DoughTemperature = sumW > 0.0f ? sumT / sumW : m_AmbientTemperature;
+    m_DoughCO2 = sumW > 0.0f ? sumC / sumW : 0.0f;
+}
+
+void ProofingField::Diffuse(std::vector<float>& field, float diffusivity, float dt, float boundary, bool insulated) {
+    const float kx = diffusivity * dt / (m_CellSize.x * m_CellSize.x);
+    const float ky = diffusivity * dt / (m_CellSize.y * m_CellSize.y);
+    const float kz = diffusivity * dt / (m_CellSize.z * m_CellSize.z);
+    const float* f = field.data();
+    const float* in = m_Interior.data();
+    float* next = m_Next.data();
+    const int sy = P, sz = P * P;
+
+    // 7-point stencil; x rows are contiguous and vectorised. Insulated walls weight their neighbour
+    // by the interior mask (no flux), Dirichlet walls are read as they are (held at 'boundary').
+    #pragma omp parallel for
+    for (int z = 1; z <= N; ++z) {
+        for (int y = 1; y <= N; ++y) {
+            int row = Index(0, y, z);
+            #pragma omp simd
+            for (int x = 1; x <= N; ++x) {
+                int i = row + x;
+                float c = f[i];
+                float wxm = insulated ? in[i - 1] : 1.0f, wxp = insulated ? in[i + 1] : 1.0f;
+                float wym = insulated ? in[i - sy] : 1.0f, wyp = insulated ? in[i + sy] : 1.0f;
+                float wzm = insulated ? in[i - sz] : 1.0f, wzp = insulated ? in[i + sz] : 1.0f;
+                float lap = kx * (wxm * (f[i - 1] - c) + wxp * (f[i + 1] - c)) +
+                            ky * (wym * (f[i - sy] - c) + wyp * (f[i + sy] - c)) +
+                            kz * (wzm * (f[i - sz] - c) + wzp * (f[i + sz] - c));
+                next[i] = in[i] * (c + lap) + (1.0f - in[i]) * boundary;
+            }
+        }
+    }
+
+    // Padding keeps the wall value; copy only the interior block back
+    for (int z = 1; z <= N; ++z) {
+        for (int y = 1; y <= N; ++y) {
+            int row = Index(1, y, z);
+            std::copy(next + row, next + row + N, field.data() + row);
+        }
+    }
+    if (!insulated) {
+        // Walls of the padding layer were never written: hold them at the boundary value
+        for (int i = 0; i < P * P * P; ++i) {
+            if (in[i] == 0.0f) field[i] = boundary;
+        }
+    }
+}
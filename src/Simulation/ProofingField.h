@@ -0,0 +1,59 @@
+#pragma once
+#include "Agent.h"
+#include <vector>
+
+// Coarse Eulerian background for proofing and baking: temperature and dissolved CO2 on a small grid
+// over the bowl. Heat diffuses in from the bowl walls and lid (held at the ambient / oven temperature);
+// yeast in cells occupied by dough produces CO2, which diffuses and escapes from cells without dough.
+// Agents only sample it (nearest cell), so it costs a few lookups per agent plus a tiny stencil.
+class ProofingField {
+public:
+    static constexpr int N = 16;        // Cells per axis
+
+    // Covers the cylinder of the given radius between floorY and lidY, dough starting at 'temperature'.
+    // The current agents calibrate how many of them make a cell "full" of dough.
+    void Init(float radius, float floorY, float lidY, float temperature, const std::vector<Agent>& agents);
+    // Deposits the dough occupancy and advances both fields by dt (sub-stepped for stability)
+    void Update(const std::vector<Agent>& agents, float dt);
+
+    float TemperatureAt(const glm::vec3& p) const { return m_Temperature[CellOf(p)]; }
+    float CO2At(const glm::vec3& p) const { return m_CO2[CellOf(p)]; }
+    // Gas pressure relative to CO2 saturation at 25 C (ideal gas: p ~ c T)
+    float PressureAt(const glm::vec3& p) const {
+        int c = CellOf(p);
+        return m_CO2[c] * (m_Temperature[c] + 273.15f) / 298.15f;
+    }
+
+    // Means over the cells holding dough, for the UI
+    float GetDoughTemperature() const { return m_DoughTemperature; }
+    float GetDoughCO2() const { return m_DoughCO2; }
+
+    float m_AmbientTemperature = 25.0f; // Walls and lid (raise it to bake)
+    float m_HeatDiffusivity = 0.002f;   // m^2/s, exaggerated so proofing fits in simulated minutes
+    float m_CO2Diffusivity = 0.001f;
+    float m_YeastRate = 0.05f;          // CO2 per second in a full cell at the optimum temperature
+    float m_YeastOptimum = 35.0f;       // C; activity falls to zero 20 C either side (above: yeast dies)
+    float m_CO2Escape = 2.0f;           // 1/s, loss from cells without dough (gas leaves the surface)
+    float m_MaxDoughTemperature = 100.0f; // Evaporation keeps the crumb at or below boiling
+
+private:
+    // Cells are padded by one layer on every side so the stencil needs no bounds checks
+    static constexpr int P = N + 2;
+    static int Index(int x, int y, int z) { return x + P * (y + P * z); }
+    int CellOf(const glm::vec3& p) const;
+
+    void Deposit(const std::vector<Agent>& agents);
+    // Explicit step of df/dt = D lap(f). Walls either hold 'boundary' (Dirichlet) or pass no flux (insulated).
+    void Diffuse(std::vector<float>& field, float diffusivity, float dt, float boundary, bool insulated);
+
+    glm::vec3 m_Origin = glm::vec3(0.0f);
+    glm::vec3 m_CellSize = glm::vec3(1.0f);
+    std::vector<float> m_Temperature;
+    std::vector<float> m_CO2;
+    std::vector<float> m_Next;
+    std::vector<float> m_Interior;      // 1 inside the bowl, 0 for walls, lid, floor and padding
+    std::vector<float> m_Dough;         // Occupancy 0..1 per cell
+    float m_CellCapacity = 1.0f;        // Agents that make a cell "full"
+    float m_DoughTemperature = 0.0f;
+    float m_DoughCO2 = 0.0f;
+};
@@ -0,0 +1,202 @@
+#include "Rheometer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+std::vector<Rheometer::Result> Rheometer::Run(const SimulationEngine& dough, const std::vector<Test>& tests) const {
+    std::vector<Result> results(tests.size());
+
+    // Several tests: one copy per thread, the engine loops inside each run serially (no nested OpenMP
+    // teams). A lone test runs on the calling thread, so its engine loops get the whole team.
+    #pragma omp parallel for schedule(dynamic) if(tests.size() > 1)
+    for (int i = 0; i < (int)tests.size(); ++i) {
+        results[i] = RunOne(dough, tests[i]);
+    }
+    return results;
+}
+
+Rheometer::Result Rheometer::RunOne(const SimulationEngine& dough, const Test& test) const {
+    Result result;
+    result.test = test;
+
+    std::unique_ptr<SimulationEngine> sample = dough.Clone();
+    SimulationEngine& engine = *sample;
+    engine.m_Boundaries = false;
+    engine.m_Periodic = false;              // The clamps need open ends
+    engine.m_GravityMode = SimulationEngine::NONE;
+    engine.m_Temperature = 0.0f;            // Jitter would end up in the measured force
+    engine.m_SpringExpansionRate = 0.0f;    // The material must not rise while it is measured
+    engine.m_UseField = false;
+    engine.m_UseTaskGraph = false;          // OpenMP loops, which nest inside Run's parallel tests
+    engine.m_SpatialSort = false;           // The clamp lists below hold agent indices
+    engine.m_RemoveEscapedAgents = false;
+    engine.m_AllowSleep = false;            // A sleeping region would not carry the imposed strain
+    engine.WakeAll();
+
+    auto& agents = engine.m_Agents;
+    if (agents.empty()) return result;
+
+    // Sample geometry from ranks, not extremes: a few stray agents above the dough must not define the clamps.
+    // The clamps hold the lowest and highest m_ClampFraction of the agents.
+    std::vector<float> heights;
+    glm::vec2 centre(0.0f);
+    for (const auto& a : agents) {
+        heights.push_back(a.position.y);
+        centre += glm::vec2(a.position.x, a.position.z);
+    }
+    centre /= (float)agents.size();
+    std::sort(heights.begin(), heights.end());
+    int clampCount = (int)(heights.size() * m_ClampFraction);
+    float bottomY = heights[clampCount];
+    float topY = heights[heights.size() - 1 - clampCount];
+    float gauge = topY - bottomY;
+
+    // Footprint: a uniform disk of radius R has mean r^2 = R^2 / 2
+    float meanR2 = 0.0f;
+    for (const auto& a : agents) {
+        glm::vec2 d = glm::vec2(a.position.x, a.position.z) - centre;
+        meanR2 += glm::dot(d, d);
+    }
+    meanR2 /= (float)agents.size();
+    float area = 3.14159f * 2.0f * meanR2;
+    if (gauge <= 0.0f || area <= 0.0f) return result;
+
+    std::vector<int> top;
+    std::vector<glm::vec3> topStart;
+    for (int i = 0; i < (int)agents.size(); ++i) {
+        Agent& a = agents[i];
+        if (a.position.y < bottomY) {
+            a.isFixed = true;
+        } else if (a.position.y > topY) {
+            a.isFixed = true;
+            top.push_back(i);
+            topStart.push_back(a.position);
+        }
+        a.prevPosition = a.position; // Start at rest
+    }
+    engine.m_HasInactiveAgents = true;
+
+    // Force the sample exerts on the top clamp (fixed agents still accumulate forces, they are just not moved)
+    auto reaction = [&]() {
+        glm::vec3 force(0.0f);
+        for (int i : top) force += agents[i].force + engine.m_SpringForces[i];
+        return force;
+    };
+    auto moveTopClamp = [&](const glm::vec3& displacement) {
+        for (size_t k = 0; k < top.size(); ++k) {
+            Agent& a = agents[top[k]];
+            a.prevPosition = a.position;
+            a.position = topStart[k] + displacement;
+        }
+    };
+
+    // Let contacts settle around the clamps; what is left is pre-stress, not response
+    glm::vec3 baseline(0.0f);
+    int baselineSamples = 0;
+    for (int step = 0; step < m_RelaxSteps; ++step) {
+        engine.Update(m_Dt);
+        if (step >= m_RelaxSteps / 2) {
+            baseline += reaction();
+            baselineSamples++;
+        }
+    }
+    if (baselineSamples > 0) baseline /= (float)baselineSamples;
+    int brokenBefore = engine.m_BrokenBondsTotal;
+
+    if (test.protocol == OSCILLATORY_SHEAR) {
+        float omega = 2.0f * 3.14159f * test.frequency;
+        int steps = (int)std::ceil(test.cycles / (test.frequency * m_Dt));
+        int analysisStart = test.cycles > 1 ? (int)std::ceil(1.0f / (test.frequency * m_Dt)) : 0;
+
+        // Fourier projection over whole cycles: tau = amplitude * (G' sin(wt) + G'' cos(wt))
+        float inPhase = 0.0f, outOfPhase = 0.0f, analysedTime = 0.0f;
+        for (int step = 1; step <= steps; ++step) {
+            float t = step * m_Dt;
+            float strain = test.amplitude * std::sin(omega * t);
+            moveTopClamp(glm::vec3(strain * gauge, 0.0f, 0.0f));
+            engine.Update(m_Dt);
+
+            float stress = -(reaction() - baseline).x / area;
+            result.strain.push_back(strain);
+            result.stress.push_back(stress);
+            result.peakStress = std::max(result.peakStress, std::abs(stress));
+
+            if (step > analysisStart) {
+                inPhase += stress * std::sin(omega * t) * m_Dt;
+                outOfPhase += stress * std::cos(omega * t) * m_Dt;
+                analysedTime += m_Dt;
+            }
+        }
+        if (analysedTime > 0.0f && test.amplitude > 0.0f) {
+            result.storageModulus = 2.0f * inPhase / (test.amplitude * analysedTime);
+            result.lossModulus = 2.0f * outOfPhase / (test.amplitude * analysedTime);
+        }
+        result.modulus = std::sqrt(result.storageModulus * result.storageModulus +
+                                   result.lossModulus * result.lossModulus);
+    } else {
+        // Tensile pulls the top clamp up, compression pushes it down; compressive stress is negative
+        float sign = test.protocol == TENSILE ? 1.0f : -1.0f;
+        int steps = test.strainRate > 0.0f ? (int)std::ceil(test.maxStrain / (test.strainRate * m_Dt)) : 0;
+
+        float fitSS = 0.0f, fitEE = 0.0f;
+        int peakIndex = -1;
+        for (int step = 1; step <= steps; ++step) {
+            float strain = sign * std::min(test.strainRate * step * m_Dt, test.maxStrain);
+            moveTopClamp(glm::vec3(0.0f, strain * gauge, 0.0f));
+            engine.Update(m_Dt);
+
+            float stress = -(reaction() - baseline).y / area;
+            result.strain.push_back(strain);
+            result.stress.push_back(stress);
+
+            if (std::abs(strain) <= m_LinearStrain) {
+                fitSS += stress * strain;
+                fitEE += strain * strain;
+            }
+            if (sign * stress > result.peakStress) {
+                result.peakStress = sign * stress;
+                peakIndex = (int)result.stress.size() - 1;
+            }
+        }
+        if (fitEE > 0.0f) result.modulus = fitSS / fitEE; // Least squares through the origin
+
+        // Failure: the stress collapsed after its peak (bonds tore instead of just stretching)
+        if (test.protocol == TENSILE && peakIndex >= 0) {
+            for (size_t k = peakIndex + 1; k < result.stress.size(); ++k) {
+                if (result.stress[k] < 0.5f * result.peakStress) {
+                    result.failureStrain = result.strain[peakIndex];
+                    break;
+                }
+            }
+        }
+    }
+
+    result.brokenBonds = engine.m_BrokenBondsTotal - brokenBefore;
+    return result;
+}
+
+std::vector<Rheometer::Test> Rheometer::AmplitudeSweep(float minAmplitude, float maxAmplitude, int points, float frequency) {
+    std::vector<Test> tests;
+    for (int i = 0; i < points; ++i) {
+        float f = points > 1 ? (float)i / (points - 1) : 0.0f;
+        Test test;
+        test.protocol = OSCILLATORY_SHEAR;
+        test.amplitude = minAmplitude * std::pow(maxAmplitude / minAmplitude, f); // Log-spaced
+        test.frequency = frequency;
+        tests.push_back(test);
+    }
+    return tests;
+}
+
+std::vector<Rheometer::Test> Rheometer::FrequencySweep(float minFrequency, float maxFrequency, int points, float amplitude) {
+    std::vector<Test> tests;
+    for (int i = 0; i < points; ++i) {
+        float f = points > 1 ? (float)i / (points - 1) : 0.0f;
+        Test test;
+        test.protocol = OSCILLATORY_SHEAR;
+        test.frequency = minFrequency * std::pow(maxFrequency / minFrequency, f);
+        test.amplitude = amplitude;
+        tests.push_back(test);
+    }
+    return tests;
+}
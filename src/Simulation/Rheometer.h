@@ -0,0 +1,52 @@
+#pragma once
+#include "SimulationEngine.h"
+#include <vector>
+
+// Virtual rheometer: measures material properties of a dough snapshot.
+// The sample is taken out of the bowl (no container, mixer, gravity or thermal jitter), its bottom and top
+// layers are clamped with Agent::isFixed, and the top clamp follows a prescribed strain history while the
+// force the sample exerts on it is recorded. Every test runs on its own copy of the snapshot, in parallel.
+class Rheometer {
+public:
+    enum Protocol { TENSILE, COMPRESSION, OSCILLATORY_SHEAR };
+
+    struct Test {
+        Protocol protocol = TENSILE;
+        // Tensile / compression: constant strain-rate ramp up to maxStrain
+        float maxStrain = 0.5f;
+        float strainRate = 0.5f;        // 1/s
+        // Oscillatory shear: gamma(t) = amplitude * sin(2 pi frequency t)
+        float amplitude = 0.05f;
+        float frequency = 1.0f;         // Hz
+        int cycles = 3;                 // The first cycle is a run-in and not analysed
+    };
+
+    struct Result {
+        Test test;
+        float modulus = 0.0f;           // Young's modulus (ramps, small-strain fit) or |G*| (oscillatory), Pa
+        float storageModulus = 0.0f;    // G'
+        float lossModulus = 0.0f;       // G''
+        float peakStress = 0.0f;
+        float failureStrain = -1.0f;    // Strain at peak stress once the stress fell below half of it, -1 = no failure
+        int brokenBonds = 0;
+        std::vector<float> strain;      // Recorded history, one sample per step
+        std::vector<float> stress;
+    };
+
+    // Clamps and measurement
+    float m_ClampFraction = 0.15f;      // Share of the agents (lowest / highest) held by each clamp
+    float m_LinearStrain = 0.05f;       // Ramps: modulus fitted on |strain| below this
+    float m_Dt = 0.01f;                 // Same fixed step as the interactive simulation
+    int m_RelaxSteps = 200;             // Settling with clamps in place; its mean reaction is the zero-stress baseline
+
+    // Runs every test on its own copy of 'dough' (in parallel when there are several); the original is
+    // not modified
+    std::vector<Result> Run(const SimulationEngine& dough, const std::vector<Test>& tests) const;
+
+    // Convenience sweeps over one checkpoint
+    static std::vector<Test> AmplitudeSweep(float minAmplitude, float maxAmplitude, int points, float frequency);
+    static std::vector<Test> FrequencySweep(float minFrequency, float maxFrequency, int points, float amplitude);
+
+private:
+    Result RunOne(const SimulationEngine& dough, const Test& test) const;
+};
@@ -5,42 +5,727 @@
 #include <random>
 #include <algorithm>
 #include <iostream>
+#include <thread>
+#include <chrono>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+    // Flour composition: 30% glutenin, 30% gliadin, the rest starch
+    AgentType FlourType(float t) {
+        if (t < 0.30f) return GLUTENIN;
+        if (t < 0.60f) return GLIADIN;
+        return STARCH;
+    }
+
+    // Counter-based random numbers for parallel loops: the value in [0, 1) depends only on (seed, index,
+    // stream), so the result is the same for any thread count or chunking
+    float CounterRandom(unsigned int index, unsigned long long stream) {
+        unsigned long long x = (stream << 32 | index) + 0x9e3779b97f4a7c15ull * 42;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return (float)(x >> 40) * (1.0f / 16777216.0f);
+    }
+
+    // Spawn streams 0-3; Brownian noise uses 4 + 3 * step + axis, so the two never collide
+    const unsigned long long SPAWN_STREAMS = 4;
+}
 
 void SimulationEngine::Init(int agentCount) {
     m_Agents.clear();
     m_Springs.clear();
+    m_PendingInserts.clear();
+    m_PendingRemovals.clear();
+    m_Pool.Reset(agentCount);
     m_Agents.reserve(agentCount);
+    m_Springs.reserve(agentCount * Interactions::MaxBonds() / 2); // Upper bound: every agent at maxBonds, two ends per spring
+    m_Grid.Invalidate();
+    m_HasInactiveAgents = false;
+    m_ShearStress = 0.0f;
+    m_StepIndex = 0;
+    m_Mixer.Update(m_Time);             // Spawn around the tool where the next step will find it
+    RebuildColliders();
+    m_ContactTable.Update(ContactSettings());
 
-    std::mt19937 gen(42);
-    std::uniform_real_distribution<float> distR(0.0f, m_ContainerRadius * 0.9f); // Keep slightly away from walls
-    std::uniform_real_distribution<float> distTheta(0.0f, 2.0f * 3.14159f);
-    std::uniform_real_distribution<float> distY(m_FloorY + 0.1f, m_FloorY + 1.0f); // Fill bottom 1.0m
-    std::uniform_real_distribution<float> distType(0.0f, 1.0f);
+    // Jittered lattice: sites 'spacing' apart, each agent displaced by at most spacing / 2 - its radius
+    // per axis, so no two agents overlap as long as the spacing fits the largest species.
+    float maxRadius = 0.0f;
+    for (const auto& species : Interactions::SPECIES) maxRadius = std::max(maxRadius, species.radius);
+    std::vector<glm::vec3> sites(agentCount);
+    float spacing;
+    if (m_Periodic) {
+        // The whole box, evenly: n sites per axis with n^3 >= agentCount, a shuffled share of them used
+        ConfigureBox();
+        glm::ivec3 n = glm::max(glm::ivec3(glm::ceil(m_Box.size / std::cbrt(m_Box.size.x * m_Box.size.y * m_Box.size.z /
+                                                                             std::max(agentCount, 1)))), glm::ivec3(1));
+        glm::vec3 step = m_Box.size / glm::vec3(n);
+        spacing = std::min(step.x, std::min(step.y, step.z));
+        std::vector<int> order(n.x * n.y * n.z);
+        for (int k = 0; k < (int)order.size(); ++k) order[k] = k;
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+        #pragma omp parallel for
+        for (int i = 0; i < agentCount; ++i) {
+            int k = order[i];
+            glm::vec3 cell((float)(k % n.x), (float)(k / n.x % n.y), (float)(k / (n.x * n.y)));
+            sites[i] = m_Box.min + (cell + 0.5f) * step;
+        }
+    } else {
+        // The lattice fills the bottom 1.0m (as far from the wall as before) and grows upwards when the
+        // agents do not fit there, up to the lid; past that the spacing shrinks and the relaxation below
+        // pushes the overlapping agents apart.
+        float fillRadius = m_ContainerRadius * 0.9f;
+        float fillVolume = glm::pi<float>() * fillRadius * fillRadius * 1.0f;
+        spacing = std::max(std::cbrt(fillVolume / std::max(agentCount, 1)), 2.0f * maxRadius * m_SpawnClearance);
+        std::vector<glm::vec2> layer;
+        for (;;) {
+            layer.clear();
+            int reach = (int)(fillRadius / spacing);
+            for (int i = -reach; i <= reach; ++i)
+                for (int k = -reach; k <= reach; ++k)
+                    if (glm::length(glm::vec2(i, k)) * spacing <= fillRadius - 0.5f * spacing) layer.push_back(glm::vec2(i, k) * spacing);
+            int layers = (agentCount + (int)layer.size() - 1) / std::max((int)layer.size(), 1);
+            if (layer.size() > 0 && layers * spacing <= m_ContainerHeight - m_FloorY) break;
+            spacing *= 0.95f;
+        }
+        float bottom = m_FloorY + 0.5f * spacing;  // Lowest agents rest on the floor
+        // Shuffled once so the partial top layer is spread over the whole disk
+        std::shuffle(layer.begin(), layer.end(), std::mt19937(42));
+        int perLayer = (int)layer.size();
+        #pragma omp parallel for
+        for (int i = 0; i < agentCount; ++i) {
+            glm::vec2 site = layer[i % perLayer];
+            sites[i] = glm::vec3(site.x, bottom + (i / perLayer) * spacing, site.y);
+        }
+    }
 
+    m_Agents.resize(agentCount, Agent(0, glm::vec3(0.0f), GLUTENIN));
+    #pragma omp parallel for
     for (int i = 0; i < agentCount; ++i) {
-        float r = std::sqrt(distR(gen)); // Sqrt for uniform area distribution
-        float theta = distTheta(gen);
-        float y = distY(gen);
-        
-        glm::vec3 pos(r * cos(theta), y, r * sin(theta));
-        
-        AgentType type = STARCH;
-        float t = distType(gen);
-        if (t < 0.30f) type = GLUTENIN;
-        else if (t < 0.60f) type = GLIADIN;
-        // No YEAST agents anymore
-        
-        m_Agents.emplace_back(i, pos, type);
+        AgentType type = FlourType(CounterRandom(i, 0));
+        float jitter = std::max(0.0f, 0.5f * spacing - Interactions::Of(type).radius);
+        glm::vec3 offset(CounterRandom(i, 1), CounterRandom(i, 2), CounterRandom(i, 3));
+        m_Agents[i].Reset(i, sites[i] + (offset * 2.0f - 1.0f) * jitter, type);
+    }
+    RelaxOverlaps();
+    m_Pool.Reindex(m_Agents);
+    ResetField();
+    m_SleepingCount = 0;
+    ResetSleepTracking();
+}
+
+// Jacobi steps of overlap removal: every agent moves by a fraction of its summed contact push
+// (gradient descent on the repulsion energy) and out of the mixer, clamped into the bowl. No velocities result: the
+// previous positions follow. Stops early once the largest summed overlap is below the tolerance.
+void SimulationEngine::RelaxOverlaps() {
+    int count = (int)m_Agents.size();
+    m_InitOverlap = 0.0f;
+    if (m_InitRelaxIterations <= 0 || count == 0) return;
+    if (m_Periodic) m_Grid.SetPeriodicBox(m_Box);
+    else m_Grid.ClearPeriodicBox();
+
+    // Plain linear repulsion whatever the contact settings: adhesion would clump the lattice
+    ContactTable overlaps;
+    overlaps.Update({ m_RepulsionK, ContactTable::LINEAR, 0.0f, 0.0f });
+    std::vector<glm::vec3> push(count);
+    float step = 0.25f / m_RepulsionK; // Under-relaxed: an agent may be pushed from several sides at once
+    for (int iteration = 0; iteration < m_InitRelaxIterations; ++iteration) {
+        m_Grid.Rebuild(m_Agents);
+        m_PackedCells.Build(m_Agents, m_Grid, overlaps);
+        float largest = 0.0f;
+        #pragma omp parallel for reduction(max:largest)
+        for (int i = 0; i < count; ++i) {
+            const Agent& agent = m_Agents[i];
+            glm::vec3 force = m_PackedCells.Repulsion(m_Grid.GetCellCoords(agent.position), agent.position, agent.type);
+            push[i] = force * step;
+            largest = std::max(largest, glm::length(force) / m_RepulsionK);
+            // Agents spawned inside the mixer are moved out of it entirely
+            glm::vec3 toolNormal;
+            float toolOverlap = m_Periodic ? 0.0f : agent.Radius() - m_Tool.Distance(agent.position, toolNormal);
+            if (toolOverlap > 0.0f) {
+                push[i] += toolNormal * toolOverlap;
+                largest = std::max(largest, toolOverlap);
+            }
+        }
+        m_InitOverlap = largest;
+        if (largest < m_InitRelaxTolerance) break;
+
+        #pragma omp parallel for
+        for (int i = 0; i < count; ++i) {
+            Agent& agent = m_Agents[i];
+            float radius = agent.Radius();
+            glm::vec3 p = agent.position + push[i];
+            if (m_Periodic) {
+                m_Box.Wrap(p);
+                agent.position = agent.prevPosition = p;
+                continue;
+            }
+            p.y = glm::clamp(p.y, m_FloorY + radius, m_ContainerHeight - radius);
+            float wall = m_ContainerRadius - radius;
+            float r2 = p.x * p.x + p.z * p.z;
+            if (r2 > wall * wall) {
+                float scale = wall / std::sqrt(r2);
+                p.x *= scale;
+                p.z *= scale;
+            }
+            agent.position = agent.prevPosition = p;
+        }
+    }
+    m_Grid.Invalidate();
+}
+
+void SimulationEngine::ConfigureBox() {
+    // Whole grid cells, centred in the grid as far as the cell count allows
+    glm::ivec3 dimensions = m_Grid.GetDimensions();
+    float cellSize = m_Grid.GetCellSize();
+    m_Box.cells = glm::clamp(glm::ivec3(m_BoxCells), glm::ivec3(3), dimensions);
+    m_Box.firstCell = (dimensions - m_Box.cells) / 2;
+    m_Box.cellSize = cellSize;
+    m_Box.min = glm::vec3(m_Box.firstCell) * cellSize - 5.0f;  // The grid starts at -5 on every axis
+    m_Box.size = glm::vec3(m_Box.cells) * cellSize;
+    m_Box.shearRate = m_ShearRate;
+    m_Box.shearOffset = 0.0f;
+    m_StepsSinceStress = 0;
+    m_ShearStress = 0.0f;
+}
+
+void SimulationEngine::MeasureShearStress() {
+    // Virial over pairs: -P_xy = -(1/V) sum r_ij.x f_ij.y, with r_ij = r_i - r_j and f_ij the force on i.
+    // Contacts are walked from both ends (hence the half), bonds once. Thermal motion is not included.
+    m_Grid.SetPeriodicBox(m_Box);
+    m_Grid.Update(m_Agents);
+    int count = (int)m_Agents.size();
+    double contacts = 0.0;
+    #pragma omp parallel for reduction(+:contacts)
+    for (int i = 0; i < count; ++i) {
+        const Agent& agent = m_Agents[i];
+        m_Grid.ForEachNeighbor(agent.position, [&](Agent* neighbor) {
+            if (neighbor == &agent) return;
+            glm::vec3 r = m_Box.MinimumImage(agent.position - neighbor->position);
+            float d2 = glm::length2(r);
+            if (d2 < m_ContactTable.Cutoff2(agent.type, neighbor->type) && d2 > 1e-8f) {
+                contacts += r.x * r.y * m_ContactTable.Scale(agent.type, neighbor->type, d2);
+            }
+        });
+    }
+    double bonds = 0.0;
+    for (const auto& spring : m_Springs) {
+        glm::vec3 r = m_Box.MinimumImage(spring.a->position - spring.b->position);
+        float length = glm::length(r);
+        if (length > 0.0001f) bonds -= r.x * r.y * spring.springConstant * (length - spring.restLength) / length;
+    }
+    float volume = m_Box.size.x * m_Box.size.y * m_Box.size.z;
+    m_ShearStress = (float)(-(0.5 * contacts + bonds) / volume);
+}
+
+void SimulationEngine::ResetField() {
+    m_Field.Init(m_ContainerRadius, m_FloorY, m_ContainerHeight, m_Temperature, m_Agents);
+    m_StepsSinceField = 0;
+}
+
+void SimulationEngine::UpdateField() {
+    // The field changes on a scale of seconds; stepping it with the particles would only cost time
+    if (!m_UseField || ++m_StepsSinceField < m_FieldInterval) return;
+    m_StepsSinceField = 0;
+    m_Field.Update(m_Agents, m_StepDt * m_FieldInterval);
+}
+
+float SimulationEngine::BondProbabilityAt(const glm::vec3& p) const {
+    if (!m_UseField) return m_BondProbability;
+    float rate = std::pow(m_BondQ10, (m_Field.TemperatureAt(p) - 25.0f) / 10.0f);
+    return std::min(1.0f, m_BondProbability * rate);
+}
+
+std::unique_ptr<SimulationEngine> SimulationEngine::Clone() const {
+    std::unique_ptr<SimulationEngine> copy(new SimulationEngine(*this));
+    for (auto& spring : copy->m_Springs) {
+        spring.a = copy->m_Agents.data() + (spring.a - m_Agents.data());
+        spring.b = copy->m_Agents.data() + (spring.b - m_Agents.data());
     }
+    copy->m_Grid.Invalidate();
+    for (const auto& insert : copy->m_PendingInserts) copy->m_Pool.Release(insert.slot);
+    copy->m_PendingInserts.clear();
+    copy->m_PendingRemovals.clear();
+    return copy;
+}
+
+AgentHandle SimulationEngine::QueueInsert(AgentType type, const glm::vec3& position, const glm::vec3& velocity) {
+    int slot = m_Pool.Acquire();
+    m_PendingInserts.push_back({ slot, type, position, velocity });
+    return m_Pool.HandleOf(slot);
+}
+
+void SimulationEngine::QueueRemove(AgentHandle handle) {
+    // Still queued for insertion: cancel it, which frees the slot and makes the handle stale
+    for (auto it = m_PendingInserts.begin(); it != m_PendingInserts.end(); ++it) {
+        if (m_Pool.HandleOf(it->slot) != handle) continue;
+        m_PendingInserts.erase(it);
+        m_Pool.Release(handle.slot);
+        return;
+    }
+    m_PendingRemovals.push_back(handle);
+}
+
+const Agent* SimulationEngine::Resolve(AgentHandle handle) const {
+    int index = m_Pool.IndexOf(handle);
+    return index >= 0 ? &m_Agents[index] : nullptr;
+}
+
+void SimulationEngine::AddFlour(int count) {
+    float top = m_FloorY;
+    for (const auto& a : m_Agents) top = std::max(top, a.position.y);
+    float low = std::min(top + 0.1f, m_ContainerHeight - 0.3f);
+
+    std::uniform_real_distribution<float> dist01(0.0f, 1.0f);
+    std::uniform_real_distribution<float> distTheta(0.0f, 2.0f * 3.14159f);
+    std::uniform_real_distribution<float> distY(low, low + 0.2f);
+    for (int i = 0; i < count; ++i) {
+        float r = m_ContainerRadius * 0.8f * std::sqrt(dist01(m_SpawnRng)); // Uniform over the disk
+        float theta = distTheta(m_SpawnRng);
+        glm::vec3 pos(r * cos(theta), distY(m_SpawnRng), r * sin(theta));
+        QueueInsert(FlourType(dist01(m_SpawnRng)), pos);
+    }
+}
+
+bool SimulationEngine::UpdatePopulation() {
+    if (m_RemoveEscapedAgents && ++m_StepsSinceEscapeCheck >= m_EscapeCheckInterval) {
+        m_StepsSinceEscapeCheck = 0;
+        float floor = m_FloorY - m_EscapeMargin;
+        float lid = m_ContainerHeight + m_EscapeMargin;
+        float wall = m_ContainerRadius + m_EscapeMargin;
+        for (const auto& a : m_Agents) {
+            if (a.isGhost) continue;
+            const glm::vec3& p = a.position;
+            // Written so that NaN positions count as escaped too (the periodic box only loses those)
+            bool inside = m_Periodic ? p == p
+                                     : p.y >= floor && p.y <= lid && p.x * p.x + p.z * p.z <= wall * wall;
+            if (!inside) m_PendingRemovals.push_back(m_Pool.HandleOf(a.id));
+        }
+    }
+    if (!HasPendingAgentChanges()) return false;
+    ApplyAgentChanges();
+    return true;
+}
+
+void SimulationEngine::ApplyAgentChanges() {
+    int count = (int)m_Agents.size();
+
+    if (!m_PendingRemovals.empty()) {
+        m_Removed.assign(count, 0);
+        int removed = 0;
+        for (AgentHandle handle : m_PendingRemovals) {
+            int index = m_Pool.IndexOf(handle);
+            if (index < 0 || m_Removed[index]) continue; // Stale, not inserted yet, or listed twice
+            m_Removed[index] = 1;
+            removed++;
+        }
+        m_PendingRemovals.clear();
+
+        if (removed > 0) {
+            // Bonds to removed agents disappear (not counted as broken), the partner forgets them
+            Agent* base = m_Agents.data();
+            m_Springs.erase(std::remove_if(m_Springs.begin(), m_Springs.end(), [&](const Spring& spring) {
+                bool removeA = m_Removed[spring.a - base];
+                bool removeB = m_Removed[spring.b - base];
+                if (!removeA && !removeB) return false;
+                auto& aCon = spring.a->connectedAgentIDs;
+                auto& bCon = spring.b->connectedAgentIDs;
+                if (!removeA) aCon.erase(std::remove(aCon.begin(), aCon.end(), spring.b->id), aCon.end());
+                if (!removeB) bCon.erase(std::remove(bCon.begin(), bCon.end(), spring.a->id), bCon.end());
+                return true;
+            }), m_Springs.end());
+
+            // Close the gaps in place, keeping the order (and so the spatial sort)
+            m_NewIndex.resize(count);
+            int kept = 0;
+            for (int i = 0; i < count; ++i) {
+                if (m_Removed[i]) {
+                    m_Pool.Release(m_Agents[i].id);
+                    m_NewIndex[i] = -1;
+                    continue;
+                }
+                m_NewIndex[i] = kept;
+                if (kept != i) m_Agents[kept] = std::move(m_Agents[i]);
+                kept++;
+            }
+            RemapSprings(base, base, m_NewIndex);
+            m_Agents.erase(m_Agents.begin() + kept, m_Agents.end());
+            m_RemovedAgentsTotal += removed;
+        }
+    }
+
+    if (!m_PendingInserts.empty()) {
+        size_t needed = m_Agents.size() + m_PendingInserts.size();
+        if (needed > m_Agents.capacity()) {
+            // Grow through the sort buffer so the springs can be re-pointed while both arrays are alive
+            m_SortBuffer.clear();
+            m_SortBuffer.reserve(std::max(needed, m_Agents.capacity() * 2));
+            for (auto& a : m_Agents) m_SortBuffer.push_back(std::move(a));
+            RemapSprings(m_Agents.data(), m_SortBuffer.data(), {});
+            m_Agents.swap(m_SortBuffer);
+        }
+        for (const auto& insert : m_PendingInserts) {
+            m_Agents.emplace_back(insert.slot, insert.position, insert.type);
+            m_Agents.back().prevPosition = insert.position - insert.velocity * m_StepDt;
+        }
+        m_PendingInserts.clear();
+    }
+
+    m_Pool.Reindex(m_Agents);
+    m_Grid.Invalidate();
+    ResetSleepTracking();
+}
+
+void SimulationEngine::RemapSprings(const Agent* oldBase, Agent* newBase, const std::vector<int>& newIndex) {
+    // An empty table keeps every index, only the buffer moved
+    for (auto& spring : m_Springs) {
+        int a = (int)(spring.a - oldBase);
+        int b = (int)(spring.b - oldBase);
+        spring.a = newBase + (newIndex.empty() ? a : newIndex[a]);
+        spring.b = newBase + (newIndex.empty() ? b : newIndex[b]);
+    }
+}
+
+void SimulationEngine::RebuildColliders() {
+    float bottom = m_FloorY - 0.1f;
+    float top = m_ContainerHeight + 0.1f;
+    if (m_MixerTool == DOUGH_HOOK) m_Tool = Colliders::MakeDoughHook(m_Mixer.radius, bottom, top);
+    else m_Tool = Colliders::MakeRod(m_Mixer.radius, bottom, top);
+    m_Tool.SetTransform(m_Mixer.position, m_Mixer.angle);
 }
 
 void SimulationEngine::Update(float dt) {
-    // 1. Biology: Yeast Effect (Spring Expansion)
-    // Instead of growing particles, we expand the network from within
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now(), mark = start;
+    auto lap = [&](StepPhase phase) {
+        Clock::time_point now = Clock::now();
+        m_Timings.ms[phase] = std::chrono::duration<float, std::milli>(now - mark).count();
+        mark = now;
+    };
+
+    m_StepDt = dt;
+    m_StepIndex++;
+    if (m_Periodic) {
+        m_Box.shearRate = m_ShearRate;
+        m_Box.AdvanceShear(dt);
+    }
+    UpdatePopulation();
+    MaintainAgentOrder();
+    UpdateField();
+    if (m_SpringForces.size() != m_Agents.size()) m_SpringForces.resize(m_Agents.size());
+    if (m_QuietSteps.size() != m_Agents.size()) ResetSleepTracking();
+    m_ContactTable.Update(ContactSettings());
+    ApplyThreadCount();
+    // A wider search (larger collision radius, bond distance or adhesion) needs wider cells; the periodic
+    // box is made of cells, so there the next Init picks the change up
+    float required = RequiredCellSize();
+    if (!m_Periodic && m_Grid.GetCellSize() < required) m_Grid.Resize(required);
+    SleepParameters parameters = CaptureSleepParameters();
+    if (!(parameters == m_SleepParameters) || (!m_AllowSleep && m_SleepingCount > 0)) {
+        // Sleepers rest in the equilibrium of the old parameters
+        m_SleepParameters = parameters;
+        WakeAll();
+    }
+    SelectKernels();
+    lap(PHASE_MAINTENANCE);
+
+    if (m_UseTaskGraph) {
+        RunTaskGraph();
+        UpdateSleep();
+        for (int p = PHASE_GROW; p < PHASE_TOTAL; ++p) m_Timings.ms[p] = 0.0f;
+    } else {
+        int count = (int)m_Agents.size();
+
+        // 1. Biology: Yeast Effect (Spring Expansion)
+        GrowSprings(0, (int)m_Springs.size());
+        lap(PHASE_GROW);
+
+        // 2. Clear Forces & Apply Gravity/Central Force
+        #pragma omp parallel for
+        for (int c = 0; c < TASK_CHUNKS; ++c) {
+            ApplyExternalForces(ChunkBegin(c, count), ChunkBegin(c + 1, count));
+        }
+        lap(PHASE_EXTERNAL);
+
+        // 2. Spatial Grid Update
+        RebuildGrid();
+        lap(PHASE_GRID);
+
+        // 3. Chemistry: Dynamic Bond Creation
+        FormBonds();
+        lap(PHASE_BONDS);
+
+        // 4. Physics: Accumulate Forces
+        UpdateMixer();
+
+        #pragma omp parallel for
+        for (int c = 0; c < TASK_CHUNKS; ++c) {
+            AccumulateContactForces(ChunkBegin(c, count), ChunkBegin(c + 1, count));
+        }
+        lap(PHASE_CONTACTS);
+
+        // Spring Forces
+        ApplySpringForces();
+        lap(PHASE_SPRINGS);
+
+        // 5. Verlet Integration
+        #pragma omp parallel for
+        for (int c = 0; c < TASK_CHUNKS; ++c) {
+            Integrate(ChunkBegin(c, count), ChunkBegin(c + 1, count));
+        }
+        UpdateSleep();
+        lap(PHASE_INTEGRATE);
+    }
+
+    if (m_Periodic && ++m_StepsSinceStress >= m_StressInterval) {
+        m_StepsSinceStress = 0;
+        MeasureShearStress();
+    }
+
+    m_Timings.ms[PHASE_TOTAL] = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    if (m_Telemetry.publisher) PublishTelemetry();
+}
+
+SimulationEngine::SleepParameters SimulationEngine::CaptureSleepParameters() const {
+    return { { (int)m_GravityMode, (int)m_MixerTool, (int)m_UseField, (int)m_Periodic, (int)m_ContactLaw },
+             { m_Temperature, m_SpringK, m_RepulsionK, m_CollisionRadius, m_Damping, m_BreakingThreshold,
+               m_SpringExpansionRate, m_CentralForceK, m_Mixer.speed, m_Mixer.spin, m_BondDistance, m_BondProbability,
+               m_ShearRate, m_Adhesion, m_AdhesionRange } };
+}
+
+int SimulationEngine::ThreadCount() const {
+    // The default is whatever the process started with (OMP_NUM_THREADS or all cores), read before any change
+#ifdef _OPENMP
+    static const int defaultCount = omp_get_max_threads();
+#else
+    static const int defaultCount = (int)std::max(1u, std::thread::hardware_concurrency());
+#endif
+    return m_ThreadCount > 0 ? m_ThreadCount : defaultCount;
+}
+
+void SimulationEngine::ApplyThreadCount() {
+    // Per calling thread; set every step because a probe engine on the same thread may have changed it
+#ifdef _OPENMP
+    omp_set_num_threads(ThreadCount());
+#endif
+}
+
+float SimulationEngine::RequiredCellSize() const {
+    return std::max({ m_BondDistance, m_CollisionRadius, m_ContactTable.MaxCutoff() });
+}
+
+ContactTable::Settings SimulationEngine::ContactSettings() const {
+    return { m_RepulsionK, m_ContactLaw, std::max(m_Adhesion, 0.0f), glm::clamp(m_AdhesionRange, 0.0f, 0.5f) };
+}
+
+bool SimulationEngine::SleepParameters::operator==(const SleepParameters& o) const {
+    return std::equal(std::begin(modes), std::end(modes), std::begin(o.modes)) &&
+           std::equal(std::begin(values), std::end(values), std::begin(o.values));
+}
+
+void SimulationEngine::ResetSleepTracking() {
+    // Indices changed (or first step): restart the quiet counters, sleepers stay asleep
+    int count = (int)m_Agents.size();
+    m_SleepAnchor.resize(count);
+    m_QuietSteps.assign(count, 0);
+    m_Wake.assign(count, 0);
+    for (int i = 0; i < count; ++i) m_SleepAnchor[i] = m_Agents[i].position;
+}
+
+void SimulationEngine::WakeAll() {
+    for (auto& a : m_Agents) a.isSleeping = false;
+    m_SleepingCount = 0;
+    ResetSleepTracking();
+}
+
+void SimulationEngine::UpdateSleep() {
+    if (!m_AllowSleep) return;
+    int count = (int)m_Agents.size();
+    int sleeping = 0;
+    const float drift2 = m_SleepDistance * m_SleepDistance;
+    const float accel2 = m_SleepAcceleration * m_SleepAcceleration;
+
+    #pragma omp parallel for reduction(+:sleeping)
+    for (int i = 0; i < count; ++i) {
+        Agent& a = m_Agents[i];
+        bool wake = m_Wake[i] != 0;
+        m_Wake[i] = 0;
+        if (a.isFixed || a.isGhost) continue;
+
+        if (a.isSleeping) {
+            if (!wake) {
+                sleeping++;
+                continue;
+            }
+            a.isSleeping = false; // Wakes at rest (prevPosition == position)
+            m_QuietSteps[i] = 0;
+            m_SleepAnchor[i] = a.position;
+            continue;
+        }
+
+        // Quiet = stayed near the anchor (thermal jitter averages out) without a large net force
+        glm::vec3 accel = (a.force + m_SpringForces[i]) * a.InvMass();
+        if (glm::length2(a.position - m_SleepAnchor[i]) > drift2 || glm::length2(accel) > accel2) {
+            m_SleepAnchor[i] = a.position;
+            m_QuietSteps[i] = 0;
+            continue;
+        }
+        if (++m_QuietSteps[i] >= m_SleepSteps) {
+            a.isSleeping = true;
+            a.prevPosition = a.position;
+            sleeping++;
+        }
+    }
+    m_SleepingCount = sleeping;
+}
+
+bool SimulationEngine::OpenTelemetry(const char* stream) {
+    auto publisher = std::make_unique<TelemetryPublisher>();
+    if (!publisher->Open(stream)) return false;
+    m_Telemetry.publisher = std::move(publisher);
+    return true;
+}
+
+void SimulationEngine::CloseTelemetry() {
+    m_Telemetry.publisher.reset();
+}
+
+void SimulationEngine::PublishTelemetry() {
+    TelemetryRecord record = {};
+    record.simTime = m_Time;
+    record.agents = (int32_t)m_Agents.size();
+    record.bonds = (int32_t)m_Springs.size();
+    record.brokenBonds = m_BrokenBondsTotal;
+    record.youngsModulus = GetYoungsModulus();
+    for (int p = 0; p < PHASE_COUNT; ++p) record.phaseMs[p] = m_Timings.ms[p];
+    m_Telemetry.publisher->Publish(record);
+}
+
+void SimulationEngine::RunTaskGraph() {
+    TaskGraph& graph = m_Scheduling.graph;
+    if (!m_Scheduling.scheduler || m_Scheduling.scheduler->GetThreadCount() != ThreadCount()) {
+        m_Scheduling.scheduler.reset();
+        m_Scheduling.scheduler = std::make_unique<TaskScheduler>(ThreadCount());
+    }
+
+    if (graph.Empty()) {
+        // Built once: the chunk bounds are read when a task runs, so agent/spring counts may change.
+        // Verlet chunks wait for every contact chunk because those read neighbour positions.
+        auto agentCount = [this]() { return (int)m_Agents.size(); };
+        auto springCount = [this]() { return (int)m_Springs.size(); };
+
+        int grid = graph.Add([this]() { RebuildGrid(); });
+        int bonds = graph.Add([this]() { FormBonds(); });
+        int mixer = graph.Add([this]() { UpdateMixer(); });
+        int springs = graph.Add([this]() { ApplySpringForces(); });
+        graph.Precede(grid, bonds);
+        graph.Precede(bonds, mixer);
+        graph.Precede(bonds, springs);
+
+        std::vector<int> contacts;
+        for (int c = 0; c < TASK_CHUNKS; ++c) {
+            // Rest-length growth and force reset overlap the grid rebuild
+            int grow = graph.Add([this, c, springCount]() {
+                GrowSprings(ChunkBegin(c, springCount()), ChunkBegin(c + 1, springCount()));
+            });
+            int external = graph.Add([this, c, agentCount]() {
+                ApplyExternalForces(ChunkBegin(c, agentCount()), ChunkBegin(c + 1, agentCount()));
+            });
+            graph.Precede(grow, bonds);
+            graph.Precede(external, bonds);
+
+            // Contact forces overlap the (serial) spring phase
+            int contact = graph.Add([this, c, agentCount]() {
+                AccumulateContactForces(ChunkBegin(c, agentCount()), ChunkBegin(c + 1, agentCount()));
+            });
+            graph.Precede(mixer, contact);
+            contacts.push_back(contact);
+        }
+
+        for (int c = 0; c < TASK_CHUNKS; ++c) {
+            int integrate = graph.Add([this, c, agentCount]() {
+                Integrate(ChunkBegin(c, agentCount()), ChunkBegin(c + 1, agentCount()));
+            });
+            graph.Precede(springs, integrate);
+            for (int contact : contacts) graph.Precede(contact, integrate);
+        }
+    }
+
+    m_Scheduling.scheduler->Run(graph);
+}
+
+void SimulationEngine::MaintainAgentOrder() {
+    if (!m_SpatialSort || ++m_StepsSinceSortCheck < m_SortCheckInterval) return;
+    m_StepsSinceSortCheck = 0;
+
+    m_Locality = MeasureLocality();
+    if (m_SortCount == 0 || m_Locality < m_SortTrigger * m_SortedLocality) {
+        ReorderAgents();
+        m_SortedLocality = m_Locality = MeasureLocality();
+    }
+}
+
+float SimulationEngine::MeasureLocality() const {
+    // Share of consecutive agents in the same or an adjacent cell, i.e. how often the next agent
+    // in memory is also a neighbour in space
+    if (m_Agents.size() < 2) return 1.0f;
+    int adjacent = 0;
+    glm::ivec3 prev = m_Grid.GetCellCoords(m_Agents[0].position);
+    for (size_t i = 1; i < m_Agents.size(); ++i) {
+        glm::ivec3 cell = m_Grid.GetCellCoords(m_Agents[i].position);
+        glm::ivec3 d = glm::abs(cell - prev);
+        if (d.x <= 1 && d.y <= 1 && d.z <= 1) adjacent++;
+        prev = cell;
+    }
+    return (float)adjacent / (float)(m_Agents.size() - 1);
+}
+
+void SimulationEngine::ReorderAgents() {
+    int count = (int)m_Agents.size();
+    m_SortKeys.resize(count);
+    for (int i = 0; i < count; ++i) m_SortKeys[i] = { m_Grid.GetMortonKey(m_Agents[i].position), i };
+    std::sort(m_SortKeys.begin(), m_SortKeys.end()); // Ties keep their old relative order (index is the second key)
+
+    // Moving keeps every agent's bond list buffer, so a re-sort does not allocate once warmed up
+    m_SortBuffer.clear();
+    m_SortBuffer.reserve(m_Agents.capacity());
+    m_NewIndex.resize(count);
+    for (int i = 0; i < count; ++i) {
+        m_NewIndex[m_SortKeys[i].second] = i;
+        m_SortBuffer.push_back(std::move(m_Agents[m_SortKeys[i].second]));
+    }
+
+    // Re-point the springs and store them in the order of their first end, so the spring pass walks
+    // m_Agents and m_SpringForces roughly sequentially as well
+    RemapSprings(m_Agents.data(), m_SortBuffer.data(), m_NewIndex);
     for (auto& spring : m_Springs) {
-        // Expansion
+        if (spring.b < spring.a) std::swap(spring.a, spring.b);
+    }
+    std::sort(m_Springs.begin(), m_Springs.end(), [](const Spring& x, const Spring& y) { return x.a < y.a; });
+
+    m_Agents.swap(m_SortBuffer);
+    m_Pool.Reindex(m_Agents);
+    m_Grid.Invalidate();
+    ResetSleepTracking();
+    m_SortCount++;
+}
+
+void SimulationEngine::GrowSprings(int begin, int end) {
+    // Instead of growing particles, we expand the network from within
+    const float growth = m_SpringExpansionRate * m_StepDt * 0.01f;
+    const float perPressure = growth / m_ReferencePressure;
+    for (int i = begin; i < end; ++i) {
+        Spring& spring = m_Springs[i];
+        // Expansion (uniform, or driven by the gas pressure around the bond)
         if (spring.restLength < m_MaxSpringLength) {
-            spring.restLength += m_SpringExpansionRate * dt * 0.01f;
+            if (m_UseField) {
+                glm::vec3 mid = spring.a->position + 0.5f * Separation(spring.b->position, spring.a->position);
+                spring.restLength += perPressure * m_Field.PressureAt(mid);
+            } else {
+                spring.restLength += growth;
+            }
         }
         
         // Compression Limit (Min Length)
@@ -55,104 +740,175 @@ void SimulationEngine::Update(float dt) {
             spring.restLength = m_MinSpringLength;
         }
     }
+}
+
+void SimulationEngine::SelectKernels() {
+    bool brownian = m_Temperature > 0.0f || m_UseField;
+    switch (m_GravityMode) {
+        case GRAVITY: m_ExternalForcesKernel = SelectExternalForcesKernel<GRAVITY>(brownian, m_UseField); break;
+        case CENTRAL: m_ExternalForcesKernel = SelectExternalForcesKernel<CENTRAL>(brownian, m_UseField); break;
+        default: m_ExternalForcesKernel = SelectExternalForcesKernel<NONE>(brownian, m_UseField); break;
+    }
+
+    bool friction = m_StaticFriction > 0.0f || m_DynamicFriction > 0.0f;
+    m_FormBondsKernel = friction ? &SimulationEngine::FormBondsKernel<true> : &SimulationEngine::FormBondsKernel<false>;
+
+    BoundaryMode mode = m_Periodic ? PERIODIC : m_Boundaries ? BOWL : OPEN;
+    if (m_HasInactiveAgents || m_SleepingCount > 0) SelectBoundaryKernels<true>(mode);
+    else SelectBoundaryKernels<false>(mode);
+}
+
+template<bool SkipInactive>
+void SimulationEngine::SelectBoundaryKernels(BoundaryMode mode) {
+    switch (mode) {
+        case BOWL:
+            m_ContactKernel = &SimulationEngine::AccumulateContactForcesKernel<SkipInactive, BOWL>;
+            m_IntegrateKernel = &SimulationEngine::IntegrateKernel<SkipInactive, BOWL>;
+            break;
+        case PERIODIC:
+            m_ContactKernel = &SimulationEngine::AccumulateContactForcesKernel<SkipInactive, PERIODIC>;
+            m_IntegrateKernel = &SimulationEngine::IntegrateKernel<SkipInactive, PERIODIC>;
+            break;
+        default:
+            m_ContactKernel = &SimulationEngine::AccumulateContactForcesKernel<SkipInactive, OPEN>;
+            m_IntegrateKernel = &SimulationEngine::IntegrateKernel<SkipInactive, OPEN>;
+            break;
+    }
+}
 
-    // 2. Clear Forces & Apply Gravity/Central Force
+template<SimulationEngine::GravityMode Mode>
+SimulationEngine::RangeKernel SimulationEngine::SelectExternalForcesKernel(bool brownian, bool localTemperature) const {
+    if (!brownian) return &SimulationEngine::ApplyExternalForcesKernel<Mode, false, false>;
+    return localTemperature ? &SimulationEngine::ApplyExternalForcesKernel<Mode, true, true>
+                            : &SimulationEngine::ApplyExternalForcesKernel<Mode, true, false>;
+}
+
+void SimulationEngine::ApplyExternalForces(int begin, int end) {
+    (this->*m_ExternalForcesKernel)(begin, end);
+}
+
+template<SimulationEngine::GravityMode Mode, bool Brownian, bool LocalTemperature>
+void SimulationEngine::ApplyExternalForcesKernel(int begin, int end) {
     glm::vec3 center(0.0f, 0.0f, 0.0f);
     
-    // Brownian Motion Generator
-    static std::mt19937 gen(1337);
-    std::uniform_real_distribution<float> distBrown(-1.0f, 1.0f);
+    // Brownian noise keyed by (step, agent ID): independent of which thread runs which chunk
+    const unsigned long long noiseStream = SPAWN_STREAMS + 3 * m_StepIndex;
     float brownianStrength = m_Temperature * 0.5f; // Scale factor
 
-    #pragma omp parallel for
-    for (int i = 0; i < m_Agents.size(); ++i) {
+    for (int i = begin; i < end; ++i) {
         Agent& a = m_Agents[i];
         a.force = glm::vec3(0.0f);
+        m_SpringForces[i] = glm::vec3(0.0f);
+        if (a.isSleeping) continue;
         
         // Gravity Modes
-        if (m_GravityMode == GRAVITY) {
-            a.force += m_Gravity * a.mass;
-        } else if (m_GravityMode == CENTRAL) {
+        if (Mode == GRAVITY) {
+            a.force += m_Gravity * a.Mass();
+        } else if (Mode == CENTRAL) {
             glm::vec3 dir = center - a.position;
             a.force += dir * m_CentralForceK;
         }
         // NONE: No external force (floating)
         
         // Brownian Motion (Random Jitter)
-        if (m_Temperature > 0.0f) {
-            glm::vec3 jitter(distBrown(gen), distBrown(gen), distBrown(gen));
-            a.force += jitter * brownianStrength;
+        if (Brownian) {
+            glm::vec3 jitter(CounterRandom(a.id, noiseStream), CounterRandom(a.id, noiseStream + 1),
+                             CounterRandom(a.id, noiseStream + 2));
+            jitter = jitter * 2.0f - 1.0f;
+            float strength = LocalTemperature ? m_Field.TemperatureAt(a.position) * 0.5f : brownianStrength;
+            a.force += jitter * strength;
         }
     }
+}
 
-    // 2. Spatial Grid Update
-    m_Grid.Clear();
-    for (auto& agent : m_Agents) {
-        m_Grid.AddAgent(&agent);
-    }
+void SimulationEngine::RebuildGrid() {
+    if (m_Periodic) m_Grid.SetPeriodicBox(m_Box);
+    else m_Grid.ClearPeriodicBox();
+    // Most agents stay in their cell between 10 ms steps, so only move the ones that left it
+    if (m_IncrementalGrid) m_Grid.Update(m_Agents);
+    else m_Grid.Rebuild(m_Agents);
+    if (m_VectorContacts) m_PackedCells.Build(m_Agents, m_Grid, m_ContactTable);
+}
+
+void SimulationEngine::FormBonds() {
+    (this->*m_FormBondsKernel)();
+}
 
-    // 3. Chemistry: Dynamic Bond Creation
+template<bool Friction>
+void SimulationEngine::FormBondsKernel() {
     // Note: Cannot easily parallelize due to m_Springs modification
     for (auto& agent : m_Agents) {
-        if (agent.type == STARCH) continue; // Only Glutenin/Gliadin form bonds
-        if (agent.connectedAgentIDs.size() >= agent.maxBonds) continue;
+        if (agent.isGhost || agent.isSleeping) continue; // Ghosts are handled by their owning worker
+        // Also skips species that never bond (maxBonds 0, e.g. starch)
+        if (agent.connectedAgentIDs.size() >= agent.MaxBonds()) continue;
+        const float bondProbability = BondProbabilityAt(agent.position);
 
             m_Grid.ForEachNeighbor(agent.position, [&](Agent* neighbor) {
                 if (agent.id == neighbor->id) return;
                 
-                float distSq = glm::distance2(agent.position, neighbor->position);
+                glm::vec3 separation = Separation(agent.position, neighbor->position);
+                float distSq = glm::length2(separation);
                 float collisionRadiusSq = m_CollisionRadius * m_CollisionRadius;
                 
                 // --- 1. Volume Preservation & Friction ---
                 // We check if agents are too close (inside Collision Radius).
                 // If so, we apply a Repulsion Force to simulate volume (preventing them from merging).
-                if (distSq < collisionRadiusSq && distSq > 0.000001f) {
+                // Only agents with free bond slots get here, so the push is one-sided: in the closed periodic
+                // box it keeps heating the sample, and there the species contacts alone hold the volume.
+                if (!m_Periodic && distSq < collisionRadiusSq && distSq > 0.000001f) {
                     float dist = std::sqrt(distSq);
-                    glm::vec3 dir = (agent.position - neighbor->position) / dist;
+                    glm::vec3 dir = separation / dist;
                     float overlap = m_CollisionRadius - dist;
                     
                     // Repulsion: Proportional to overlap depth (Hooke's Law-ish)
                     glm::vec3 repulsion = dir * overlap * m_RepulsionK;
                     
-                    // Friction (Coulomb Model):
-                    // Resists relative motion between particles.
-                    // F_friction <= mu * F_normal (where F_normal is our Repulsion)
-                    glm::vec3 relVel = agent.velocity - neighbor->velocity;
-                    float v_normal = glm::dot(relVel, dir);
-                    glm::vec3 v_tangent = relVel - v_normal * dir;
-                    float vt_len = glm::length(v_tangent);
-                    
-                    glm::vec3 friction(0.0f);
-                    if (vt_len > 0.0001f) {
-                        float fn = glm::length(repulsion);
-                        // Use Static or Dynamic friction coefficient based on speed
-                        float mu = (vt_len < 0.1f) ? m_StaticFriction : m_DynamicFriction;
-                        glm::vec3 f_dir = -v_tangent / vt_len;
-                        friction = f_dir * fn * mu;
-                    }
-                    
                     // OPTIMIZATION: Lock-Free Update
                     // We only update the current 'agent'. The 'neighbor' will be updated
                     // when the outer loop reaches it. This avoids race conditions without
                     // using slow #pragma omp critical sections.
-                    agent.force += repulsion + friction;
+                    agent.force += repulsion;
+                    
+                    // Friction (Coulomb Model):
+                    // Resists relative motion between particles.
+                    // F_friction <= mu * F_normal (where F_normal is our Repulsion)
+                    if (Friction) {
+                        glm::vec3 relVel = agent.velocity - neighbor->velocity;
+                        float v_normal = glm::dot(relVel, dir);
+                        glm::vec3 v_tangent = relVel - v_normal * dir;
+                        float vt_len = glm::length(v_tangent);
+                        
+                        if (vt_len > 0.0001f) {
+                            float fn = overlap * m_RepulsionK; // |repulsion|, dir is unit length
+                            // Use Static or Dynamic friction coefficient based on speed
+                            float mu = (vt_len < 0.1f) ? m_StaticFriction : m_DynamicFriction;
+                            glm::vec3 f_dir = -v_tangent / vt_len;
+                            agent.force += f_dir * fn * mu;
+                        }
+                    }
                 }
 
             // 2. Dynamic Bond Creation (Probabilistic)
-            // Only Glutenin-Gliadin or Glutenin-Glutenin form bonds
-            bool canBond = (agent.type == GLUTENIN && neighbor->type == GLIADIN) || 
-                           (agent.type == GLUTENIN && neighbor->type == GLUTENIN);
-                           
+            // Which pairs bond, and how stiff the bond is, comes from the interaction table
+            const Interactions::Pair* pair = &Interactions::Between(agent.type, neighbor->type);
+            bool canBond = pair->canBond;
 
             // RECALCULATE dist for bonding check (since we only calculated distSq above if close)
-            float dist = glm::distance(agent.position, neighbor->position);
+            float dist = glm::length(separation);
+
+            // A bond across a domain boundary is owned by the lower ID whichever species starts it, so only
+            // that side may create it (a gliadin owner bonds its glutenin ghost from the gliadin side)
+            if (neighbor->isGhost) {
+                if (!canBond) pair = &Interactions::Between(neighbor->type, agent.type);
+                canBond = pair->canBond && agent.id < neighbor->id;
+            }
 
             if (canBond && dist < m_BondDistance) {
                 // Check probability (simulating time/temperature factor)
                 // Higher temp could actually BREAK bonds, but for formation we assume mixing helps. POPRAWIC
                 // Let's keep it simple: random chance if close.
                 static std::uniform_real_distribution<float> distProb(0.0f, 1.0f);
-                if (distProb(gen) < m_BondProbability) {
+                if (distProb(m_BondRng) < bondProbability) {
                     // Check if already connected
                     bool alreadyConnected = false;
                     for (int id : agent.connectedAgentIDs) {
@@ -160,15 +916,15 @@ void SimulationEngine::Update(float dt) {
                     }
                     
                     if (!alreadyConnected && 
-                        agent.connectedAgentIDs.size() < agent.maxBonds && 
-                        neighbor->connectedAgentIDs.size() < neighbor->maxBonds) {
+                        agent.connectedAgentIDs.size() < agent.MaxBonds() && 
+                        neighbor->connectedAgentIDs.size() < neighbor->MaxBonds()) {
                         
                         Spring newSpring;
                         newSpring.a = &agent;
                         newSpring.b = neighbor;
                         newSpring.restLength = dist;
-                        newSpring.springConstant = m_SpringK;
-                        newSpring.breakingThreshold = m_BreakingThreshold;
+                        newSpring.springConstant = m_SpringK * pair->springScale;
+                        newSpring.breakingThreshold = m_BreakingThreshold * pair->breakScale;
                         
                         // Critical section for vector modification
                         #pragma omp critical
@@ -177,66 +933,89 @@ void SimulationEngine::Update(float dt) {
                             agent.connectedAgentIDs.push_back(neighbor->id);
                             neighbor->connectedAgentIDs.push_back(agent.id);
                         }
+                        if (neighbor->isSleeping) m_Wake[neighbor - m_Agents.data()] = 1;
                     }
                 }
             }
         });
     }
+}
 
-    // 4. Physics: Accumulate Forces
-    m_Time += dt;
+void SimulationEngine::UpdateMixer() {
+    m_Time += m_StepDt;
     m_Mixer.Update(m_Time);
+    m_Tool.SetTransform(m_Mixer.position, m_Mixer.angle);
+}
 
-    #pragma omp parallel for
-    for (int i = 0; i < m_Agents.size(); ++i) {
+void SimulationEngine::AccumulateContactForces(int begin, int end) {
+    (this->*m_ContactKernel)(begin, end);
+}
+
+template<bool SkipInactive, SimulationEngine::BoundaryMode Mode>
+void SimulationEngine::AccumulateContactForcesKernel(int begin, int end) {
+    const float wake2 = m_WakeDisplacement * m_WakeDisplacement;
+    for (int i = begin; i < end; ++i) {
         auto& agent = m_Agents[i];
+        if (SkipInactive && agent.isGhost) continue;
+        if (SkipInactive && agent.isSleeping) {
+            // A sleeper only checks whether the mixer is coming for it
+            glm::vec3 toolNormal;
+            if (Mode == BOWL && m_Tool.Distance(agent.position, toolNormal) < agent.Radius() + m_WakeToolMargin) RequestWake(&agent);
+            continue;
+        }
+        // Sleepers touched by a moving agent wake up (only this agent's own step displacement is read)
+        bool moving = SkipInactive && glm::length2(agent.position - agent.prevPosition) > wake2;
         
         // Environment Forces (Gravity vs Central)
         // Gravity Modes handled above
         // if (m_UseCentralForce) { ... } removed
         
-        // Mixer Collision (Infinite Cylinder)
-        float dx = agent.position.x - m_Mixer.position.x;
-        float dz = agent.position.z - m_Mixer.position.z;
-        float distSq = dx*dx + dz*dz;
-        float minDist = m_Mixer.radius + agent.radius;
-        
-        if (distSq < minDist * minDist) {
-            float dist = std::sqrt(distSq);
-            glm::vec3 dir(dx/dist, 0.0f, dz/dist);
-            float overlap = minDist - dist;
-            
-            // Push out
-            glm::vec3 repulsion = dir * (m_RepulsionK * overlap);
-            agent.force += repulsion;
-            
-            // Friction/Drag from mixer movement could be added here
+        // Mixer Collision (SDF lookup, cost independent of the tool shape)
+        if (Mode == BOWL) {
+            glm::vec3 toolNormal;
+            float toolDist = m_Tool.Distance(agent.position, toolNormal);
+            float radius = agent.Radius();
+            if (toolDist < radius) {
+                float overlap = radius - toolDist;
+                
+                // Push out
+                agent.force += toolNormal * (m_RepulsionK * overlap);
+                
+                // Friction/Drag from mixer movement could be added here
+            }
         }
         
         // Repulsion (Variable Radius)
+        bool vector = m_VectorContacts;
+        if (vector) {
+            agent.force += m_PackedCells.Repulsion(m_Grid.GetCellCoords(agent.position), agent.position, agent.type);
+            if (!moving || m_SleepingCount == 0) continue;
+            // Otherwise the walk below only looks for sleepers to wake
+        }
         m_Grid.ForEachNeighbor(agent.position, [&](Agent* neighbor) {
             if (agent.id == neighbor->id) return;
             
-            glm::vec3 dir = agent.position - neighbor->position;
-            float dist = glm::length(dir);
-            float minDist = agent.radius + neighbor->radius;
-            
-            if (dist < minDist && dist > 0.0001f) {
-                float overlap = minDist - dist;
-                glm::vec3 direction = dir / dist;
-                glm::vec3 repulsionForce = direction * (m_RepulsionK * overlap);
-                
-                agent.force += repulsionForce;
+            glm::vec3 dir = Mode == PERIODIC ? m_Box.MinimumImage(agent.position - neighbor->position)
+                                             : agent.position - neighbor->position;
+            float d2 = glm::length2(dir);
+            if (!vector && d2 < m_ContactTable.Cutoff2(agent.type, neighbor->type) && d2 > 1e-8f) {
+                agent.force += dir * m_ContactTable.Scale(agent.type, neighbor->type, d2);
+            }
+
+            float minDist = Interactions::Between(agent.type, neighbor->type).contactDistance;
+            if (d2 < minDist * minDist && d2 > 1e-8f) {
+                if (moving && neighbor->isSleeping) RequestWake(neighbor);
             }
         });
     }
+}
 
-    // Spring Forces
+void SimulationEngine::ApplySpringForces() {
     for (auto it = m_Springs.begin(); it != m_Springs.end(); ) {
         Agent* a = it->a;
         Agent* b = it->b;
         
-        glm::vec3 dir = b->position - a->position;
+        glm::vec3 dir = Separation(b->position, a->position);
         float currentLength = glm::length(dir);
         
         // Stress / Breakage
@@ -246,9 +1025,12 @@ void SimulationEngine::Update(float dt) {
             auto& bCon = b->connectedAgentIDs;
             aCon.erase(std::remove(aCon.begin(), aCon.end(), b->id), aCon.end());
             bCon.erase(std::remove(bCon.begin(), bCon.end(), a->id), bCon.end());
+            if (a->isSleeping) RequestWake(a);
+            if (b->isSleeping) RequestWake(b);
             
             it = m_Springs.erase(it);
-            m_BrokenBondsTotal++;
+            // Cross-boundary bonds break on both workers, count them once (lower ID owns the bond)
+            if (!(a->id < b->id ? a : b)->isGhost) m_BrokenBondsTotal++;
             continue;
         }
 
@@ -257,88 +1039,89 @@ void SimulationEngine::Update(float dt) {
             float displacement = currentLength - it->restLength;
             glm::vec3 force = direction * (it->springConstant * displacement);
             
-            a->force += force;
-            b->force -= force;
+            // Kept apart from agent.force so this can run next to the contact phase
+            m_SpringForces[a - m_Agents.data()] += force;
+            m_SpringForces[b - m_Agents.data()] -= force;
+
+            // A strained bond wakes its sleeping end, so waking spreads through bonded clusters
+            if (a->isSleeping || b->isSleeping) {
+                float magnitude = std::abs(it->springConstant * displacement);
+                if (a->isSleeping && magnitude * a->InvMass() > m_SleepAcceleration) RequestWake(a);
+                if (b->isSleeping && magnitude * b->InvMass() > m_SleepAcceleration) RequestWake(b);
+            }
         }
         ++it;
     }
+}
 
-    // 5. Verlet Integration
-    for (auto& agent : m_Agents) {
-        if (agent.isFixed) continue;
+void SimulationEngine::Integrate(int begin, int end) {
+    (this->*m_IntegrateKernel)(begin, end);
+}
+
+template<bool SkipInactive, SimulationEngine::BoundaryMode Mode>
+void SimulationEngine::IntegrateKernel(int begin, int end) {
+    const float dt2 = m_StepDt * m_StepDt;
+    const float damping = m_Damping;
+    // The bowl is a capped cylinder around the Y axis: floor, lid and wall are independent clamps, so the
+    // contact response needs no SDF lookup and no projection passes
+    const float floorY = m_FloorY;
+    const float lidY = m_ContainerHeight;
+    const float wallRadius = m_ContainerRadius;
+    const ColliderMaterial cap = m_BowlCap;
+    const ColliderMaterial side = m_BowlWall;
+
+    for (int i = begin; i < end; ++i) {
+        Agent& agent = m_Agents[i];
+        if (SkipInactive && (agent.isFixed || agent.isGhost || agent.isSleeping)) continue;
 
         glm::vec3 tempPos = agent.position;
-        glm::vec3 acceleration = agent.force / agent.mass;
+        glm::vec3 acceleration = (agent.force + m_SpringForces[i]) * agent.InvMass();
         
         // Verlet: pos = pos + (pos - prevPos) * damping + a * dt^2
         glm::vec3 velocity = agent.position - agent.prevPosition;
-        agent.position = agent.position + velocity * m_Damping + acceleration * (dt * dt);
-        agent.prevPosition = tempPos;
-
-        // Floor Collision
-        if (agent.position.y < m_FloorY + agent.radius) {
-            float displacementY = agent.position.y - agent.prevPosition.y;
-            agent.position.y = m_FloorY + agent.radius;
-            
-            // Bounce
-            agent.prevPosition.y = agent.position.y + displacementY * 0.5f;
-            
-            // Friction on X/Z
-            float oldPrevX = agent.prevPosition.x;
-            float oldPrevZ = agent.prevPosition.z;
-            agent.prevPosition.x = agent.position.x - (agent.position.x - oldPrevX) * 0.9f;
-            agent.prevPosition.z = agent.position.z - (agent.position.z - oldPrevZ) * 0.9f;
+        if (Mode == PERIODIC) {
+            // Damping acts on the velocity relative to the shear flow, which would otherwise stop
+            glm::vec3 stream(m_Box.StreamVelocity(agent.position.y) * m_StepDt, 0.0f, 0.0f);
+            velocity = stream + (velocity - stream) * damping;
+            glm::vec3 position = agent.position + velocity + acceleration * dt2;
+            glm::vec3 step = position - tempPos;
+            step.x += m_Box.Wrap(position) * m_StepDt;
+            agent.position = position;
+            agent.prevPosition = position - step;
+            continue;
         }
-
-        // --- Lid Collision (Hard Clamp) ---
-        // Prevents tunneling by strictly clamping the Y position.
-        // If an agent tries to go above the lid, we force it down and invert its velocity.
-        if (agent.position.y > m_ContainerHeight - agent.radius) {
-            float displacementY = agent.position.y - agent.prevPosition.y;
-            agent.position.y = m_ContainerHeight - agent.radius; // Hard constraint
-            
-            // Bounce: Invert the vertical velocity component
-            agent.prevPosition.y = agent.position.y + displacementY * 0.5f;
-            
-            // Apply friction to horizontal movement when hitting the lid
-            float oldPrevX = agent.prevPosition.x;
-            float oldPrevZ = agent.prevPosition.z;
-            agent.prevPosition.x = agent.position.x - (agent.position.x - oldPrevX) * 0.9f;
-            agent.prevPosition.z = agent.position.z - (agent.position.z - oldPrevZ) * 0.9f;
+        glm::vec3 position = agent.position + velocity * damping + acceleration * dt2;
+        if (Mode == OPEN) {
+            agent.position = position;
+            agent.prevPosition = tempPos;
+            continue;
         }
 
-        // Cylindrical Container Collision
-        float distSq = agent.position.x * agent.position.x + agent.position.z * agent.position.z;
-        float maxDist = m_ContainerRadius - agent.radius;
-        if (distSq > maxDist * maxDist) {
-            float dist = std::sqrt(distSq);
-            glm::vec3 dir = glm::vec3(agent.position.x, 0.0f, agent.position.z) / dist;
-            
-            // Project back to edge
-            agent.position.x = dir.x * maxDist;
-            agent.position.z = dir.z * maxDist;
-            
-            // Apply friction to velocity (prevent sliding too fast)
-            // We want to kill the outward velocity component
-            glm::vec3 velocity = agent.position - agent.prevPosition;
-            glm::vec3 tangent = glm::cross(glm::vec3(0,1,0), dir);
-            float tangentSpeed = glm::dot(velocity, tangent);
-            
-            // Simple friction: just dampen previous position towards current
-             agent.prevPosition.x = agent.position.x - (agent.position.x - agent.prevPosition.x) * 0.5f;
-             agent.prevPosition.z = agent.position.z - (agent.position.z - agent.prevPosition.z) * 0.5f;
-        }
-    }
-    
-    // Debug Info (every ~60 frames assuming 0.01s step)
-    static int frameCounter = 0;
-    frameCounter++;
-    if (frameCounter % 100 == 0) {
-        // float maxY = -100.0f;
-        // for (const auto& agent : m_Agents) {
-        //     if (agent.position.y > maxY) maxY = agent.position.y;
-        // }
-        // std::cout << "Agents: " << m_Agents.size() << " | Bonds: " << m_Springs.size() << " | Max Y: " << maxY << std::endl;
+        // Container Collision, branchless: every response is blended in by a 0/1 contact mask
+        float radius = agent.Radius();
+        velocity = position - tempPos;
+
+        // Floor and lid: clamp y, bounce v.y if it points into the plane, friction on x and z
+        float y = glm::clamp(position.y, floorY + radius, lidY - radius);
+        float hitY = y != position.y ? 1.0f : 0.0f;
+        float intoY = hitY * (velocity.y * (position.y - y) > 0.0f ? 1.0f : 0.0f);
+        position.y = y;
+        velocity.y *= 1.0f - intoY * (1.0f + cap.restitution);
+        velocity *= glm::vec3(1.0f) - hitY * glm::vec3(1.0f - cap.friction, 0.0f, 1.0f - cap.friction);
+
+        // Wall: scale (x, z) back inside, bounce the radial part, friction on the tangential one
+        float r = std::sqrt(position.x * position.x + position.z * position.z);
+        float reach = wallRadius - radius;
+        float hitR = r > reach ? 1.0f : 0.0f;
+        glm::vec3 outward = glm::vec3(position.x, 0.0f, position.z) / std::max(r, 1e-6f);
+        position -= outward * (hitR * (r - reach));
+        float vRadial = glm::dot(velocity, outward);
+        float bounced = vRadial > 0.0f ? -vRadial * side.restitution : vRadial;
+        glm::vec3 tangent = velocity - outward * vRadial;
+        velocity = glm::mix(velocity, tangent * side.friction + outward * bounced, hitR);
+
+        agent.position = position;
+        agent.prevPosition = position - velocity;
     }
 }
 
@@ -347,7 +1130,7 @@ float SimulationEngine::GetYoungsModulus() const {
     
     float totalStress = 0.0f;
     for (const auto& spring : m_Springs) {
-        float currentLen = glm::distance(spring.a->position, spring.b->position);
+        float currentLen = glm::length(Separation(spring.a->position, spring.b->position));
         float displacement = std::abs(currentLen - spring.restLength);
         // Stress ~ Force = k * x
         totalStress += spring.springConstant * displacement;
@@ -1,9 +1,18 @@
 #pragma once
 #include "Agent.h"
 #include "Spring.h"
+#include "AgentPool.h"
 #include "SpatialGrid.h"
+#include "PackedCells.h"
+#include "PeriodicBox.h"
 #include "Mixer.h"
+#include "Collider.h"
+#include "TaskGraph.h"
+#include "ProofingField.h"
+#include "Telemetry.h"
 #include <vector>
+#include <memory>
+#include <random>
 
 class SimulationEngine {
 public:
@@ -12,7 +21,62 @@ public:
     void Update(float dt); 
     const std::vector<Agent>& GetAgents() const { return m_Agents; }
 
+    // Independent deep copy (bonds re-pointed at the copy's agents), e.g. a checkpoint for the Rheometer.
+    // Queued insertions and removals are not copied.
+    std::unique_ptr<SimulationEngine> Clone() const;
+
+    // Population changes are queued and applied together at the start of the next step, so springs
+    // are fixed up once per batch. An inserted agent resolves from then on; a removed one drops its bonds.
+    // Removing an agent whose insertion is still queued cancels the insertion. Init makes every
+    // earlier handle stale.
+    AgentHandle QueueInsert(AgentType type, const glm::vec3& position, const glm::vec3& velocity = glm::vec3(0.0f));
+    void QueueRemove(AgentHandle handle);
+    void AddFlour(int count);           // Random species mix (as in Init) dropped in above the dough
+    bool HasPendingAgentChanges() const { return !m_PendingInserts.empty() || !m_PendingRemovals.empty(); }
+    AgentHandle GetHandle(int index) const { return m_Pool.HandleOf(m_Agents[index].id); }
+    const Agent* Resolve(AgentHandle handle) const;   // nullptr once removed (or before insertion)
+
+    // Per-step metrics to the shared-memory stream /glutensim-<stream> (see Telemetry.h)
+    bool OpenTelemetry(const char* stream);
+    void CloseTelemetry();
+    bool IsPublishingTelemetry() const { return m_Telemetry.publisher != nullptr; }
+    const StepTimings& GetStepTimings() const { return m_Timings; }
+
 private:
+    // --- Step Phases ---
+    // Each phase works on an index range so it can be chunked (OpenMP or task graph)
+    void GrowSprings(int begin, int end);
+    void ApplyExternalForces(int begin, int end);
+    void RebuildGrid();
+    void RelaxOverlaps();               // Init: pushes overlapping agents apart before the first step
+    void FormBonds();
+    void UpdateMixer();
+    void AccumulateContactForces(int begin, int end);
+    void ApplySpringForces();
+    void Integrate(int begin, int end);
+    void RunTaskGraph();
+    void PublishTelemetry();
+    void MeasureShearStress();
+    void UpdateSleep();
+    void WakeAll();
+    void ResetSleepTracking();
+    // Raises a wake flag from a parallel phase: under the task graph the spring pass runs next to the
+    // contact chunks, and both write the flags
+    void RequestWake(const Agent* agent) {
+        unsigned char& flag = m_Wake[agent - m_Agents.data()];
+        #pragma omp atomic write
+        flag = 1;
+    }
+    void MaintainAgentOrder();
+    bool UpdatePopulation();            // Queues escaped agents, applies the batch; true if anything was queued
+    void ApplyAgentChanges();
+    void RemapSprings(const Agent* oldBase, Agent* newBase, const std::vector<int>& newIndex);
+    void ReorderAgents();
+    float MeasureLocality() const;
+
+    static const int TASK_CHUNKS = 64;
+    static int ChunkBegin(int chunk, int count) { return (int)((long long)count * chunk / TASK_CHUNKS); }
+
     std::vector<Agent> m_Agents;
     // Parameters
     glm::vec3 m_Gravity = glm::vec3(0.0f, -9.81f, 0.0f);
@@ -25,10 +89,78 @@ private:
     // Physics & Chemistry
     std::vector<Spring> m_Springs;
     SpatialGrid m_Grid;
+    bool m_IncrementalGrid = true;      // Move only agents that changed cell (full rebuild on heavy churn)
+    bool m_VectorContacts = true;       // SIMD repulsion over agents packed cell by cell (see PackedCells.h)
+    PackedCells m_PackedCells;          // Rebuilt with the grid while m_VectorContacts is on
+
+    // --- Population ---
+    struct PendingInsert {
+        int slot;
+        AgentType type;
+        glm::vec3 position;
+        glm::vec3 velocity;             // Per second, turned into a Verlet displacement with the step dt
+    };
+    AgentPool m_Pool;
+    std::vector<PendingInsert> m_PendingInserts;
+    std::vector<AgentHandle> m_PendingRemovals;
+    std::vector<char> m_Removed;        // Per agent index, scratch for a removal batch
+    bool m_RemoveEscapedAgents = false; // Agents that left the bowl (or the grid) are removed (opt-in)
+    float m_EscapeMargin = 0.5f;        // Distance past the floor / wall that counts as left
+    int m_EscapeCheckInterval = 10;     // Steps between escape checks
+    int m_StepsSinceEscapeCheck = 0;
+    int m_RemovedAgentsTotal = 0;
+    std::mt19937 m_SpawnRng{7};
+    float m_SpawnClearance = 1.05f;     // Init lattice spacing, as a multiple of the largest diameter
+    int m_InitRelaxIterations = 50;     // Overlap relaxation passes after Init (0 = off)
+    float m_InitRelaxTolerance = 1e-4f; // Stop once the largest remaining overlap is below this
+    float m_InitOverlap = 0.0f;         // Largest overlap left after the relaxation
+
+    // --- Sleeping Agents ---
+    // Agents that stayed within m_SleepDistance of one spot for m_SleepSteps steps, without a large
+    // net force, stop being integrated and skip force evaluation (they act like fixed agents).
+    // They wake on contact with a moving agent, on bond changes, on a strained bond, near the mixer,
+    // and all at once when a parameter changes. Bonds propagate waking through a cluster.
+    bool m_AllowSleep = true;
+    float m_SleepDistance = 0.002f;     // Max drift from the anchor while counting quiet steps
+    int m_SleepSteps = 60;
+    float m_SleepAcceleration = 30.0f;  // Net force / mass above this keeps (or makes) an agent awake
+    float m_WakeDisplacement = 0.004f;  // Step displacement of a neighbour that wakes a sleeper it touches
+    float m_WakeToolMargin = 0.05f;     // Sleepers this close to the mixer wake up
+    int m_SleepingCount = 0;
+    std::vector<glm::vec3> m_SleepAnchor;   // Per agent index, reset whenever indices change
+    std::vector<int> m_QuietSteps;
+    std::vector<unsigned char> m_Wake;      // Wake requests for sleepers, set by neighbours and bonds
+    struct SleepParameters {
+        int modes[5];
+        float values[15];
+        bool operator==(const SleepParameters& o) const;
+    };
+    SleepParameters CaptureSleepParameters() const;
+    SleepParameters m_SleepParameters = {};
+
+    // --- Memory Layout ---
+    // Mixing scatters spatial neighbours through m_Agents; every few steps the locality is measured and,
+    // once it fell well below what the last sort achieved, agents are re-sorted along a Morton curve.
+    // IDs are identities (bond lists, domain records), only indices and Spring pointers change.
+    bool m_SpatialSort = true;
+    int m_SortCheckInterval = 100;      // Steps between locality checks
+    float m_SortTrigger = 0.7f;         // Re-sort below this share of the post-sort locality
+    int m_StepsSinceSortCheck = 0;
+    float m_SortedLocality = 0.0f;      // Locality right after the last sort
+    float m_Locality = 0.0f;            // Last measurement
+    int m_SortCount = 0;
+    std::vector<std::pair<unsigned int, int>> m_SortKeys; // (Morton key, old index)
+    std::vector<int> m_NewIndex;        // Old index -> new index (-1 = removed), shared with removal
+    std::vector<Agent> m_SortBuffer;    // Swapped with m_Agents, keeps its capacity
     
     // --- Physics Parameters ---
     float m_SpringK = 800.0f;           // Stiffness of the gluten bonds
     float m_RepulsionK = 5000.0f;       // Repulsion force to maintain volume
+    ContactTable::Law m_ContactLaw = ContactTable::LINEAR;  // Overlap -> repulsion (see ContactTable.h)
+    float m_Adhesion = 0.0f;            // Peak pull (N) between starch and whatever it touches (0 = off, stiff above ~1% of m_RepulsionK)
+    float m_AdhesionRange = 0.3f;       // Reach of that pull past contact, fraction of the contact distance (max 0.5)
+    ContactTable m_ContactTable;        // Tabulated contact forces, resampled when the settings above change
+    ContactTable::Settings ContactSettings() const;
     float m_CollisionRadius = 0.15f;    // Radius at which repulsion activates
     float m_StaticFriction = 0.0f;      // Friction when relative velocity is low
     float m_DynamicFriction = 0.0f;     // Friction when sliding
@@ -45,16 +177,114 @@ private:
     float m_Temperature = 25.0f;        // Controls Brownian motion intensity
     float m_BondProbability = 0.1f;     // Probability of forming a bond per frame
     
+    // --- Proofing Field ---
+    // Local temperature and CO2 instead of the global m_Temperature / uniform rising: agents sample
+    // the field for Brownian jitter and bond kinetics, springs grow with the local gas pressure.
+    // Stepped every m_FieldInterval particle steps.
+    bool m_UseField = false;
+    ProofingField m_Field;
+    int m_FieldInterval = 10;
+    int m_StepsSinceField = 0;
+    float m_ReferencePressure = 0.5f;   // Local pressure at which springs grow at m_SpringExpansionRate
+    float m_BondQ10 = 2.0f;             // Bond formation speeds up this much per +10 C (relative to 25 C)
+    void ResetField();                  // Restart from m_Temperature and the current dough shape
+    void UpdateField();
+    float BondProbabilityAt(const glm::vec3& p) const;
+
     // --- Environment ---
     Mixer m_Mixer;
+    enum MixerTool { ROD, DOUGH_HOOK };
+    MixerTool m_MixerTool = ROD;
+    // The bowl is a capped cylinder, resolved by analytic clamps in IntegrateKernel: floor and lid bounce
+    // at half speed and keep 90% of the slide, the wall stops the outward motion and halves the slide
+    ColliderMaterial m_BowlCap = { 0.5f, 0.9f };
+    ColliderMaterial m_BowlWall = { 0.0f, 0.5f };
+    Collider m_Tool;                    // Moving mixer SDF, follows m_Mixer
+    void RebuildColliders();            // Re-bake after container or tool changes
     enum GravityMode { NONE, GRAVITY, CENTRAL };
     GravityMode m_GravityMode = NONE;
     float m_CentralForceK = 5.0f;       // Strength of central pull
+    bool m_Boundaries = true;           // Container and mixer collisions (off for samples taken out of the bowl)
+
+    // --- Periodic Box ---
+    // Bulk dough without walls: a cubic box of m_BoxCells grid cells per side, periodic in all three
+    // directions, replaces the bowl and the mixer (Init spawns into it). Instead of mixing, the box is
+    // sheared at m_ShearRate with Lees-Edwards boundaries, and damping acts on the velocity relative to
+    // the shear flow. Bonds and contacts use minimum-image separations; the bonding walk's extra
+    // m_CollisionRadius repulsion is left out (see FormBondsKernel).
+    bool m_Periodic = false;
+    int m_BoxCells = 6;
+    float m_ShearRate = 0.5f;           // 1/s
+    PeriodicBox m_Box;
+    void ConfigureBox();                // Box geometry from m_BoxCells (Init calls it)
+    glm::vec3 Separation(const glm::vec3& a, const glm::vec3& b) const {
+        return m_Periodic ? m_Box.MinimumImage(a - b) : a - b;
+    }
+    // Configurational shear stress -P_xy of the box (contacts and bonds), every m_StressInterval steps
+    int m_StressInterval = 10;
+    int m_StepsSinceStress = 0;
+    float m_ShearStress = 0.0f;         // Pa (N/m^2 in simulation units)
     float m_Time = 0.0f;
+    float m_StepDt = 0.0f;
+    unsigned long long m_StepIndex = 0; // Steps since Init, keys the Brownian noise
+    
+    // --- Specialized Kernels ---
+    // The phase functions above forward to template instances picked once per step by SelectKernels(),
+    // so features that are switched off (gravity mode, Brownian jitter, friction, ghost/fixed agents)
+    // compile out of the inner loops instead of being branched on per agent or per pair
+    using RangeKernel = void (SimulationEngine::*)(int, int);
+    enum BoundaryMode { OPEN, BOWL, PERIODIC };
+    void SelectKernels();
+    template<GravityMode Mode, bool Brownian, bool LocalTemperature> void ApplyExternalForcesKernel(int begin, int end);
+    template<GravityMode Mode> RangeKernel SelectExternalForcesKernel(bool brownian, bool localTemperature) const;
+    template<bool Friction> void FormBondsKernel();
+    template<bool SkipInactive, BoundaryMode Mode> void AccumulateContactForcesKernel(int begin, int end);
+    template<bool SkipInactive, BoundaryMode Mode> void IntegrateKernel(int begin, int end);
+    template<bool SkipInactive> void SelectBoundaryKernels(BoundaryMode mode);
+    RangeKernel m_ExternalForcesKernel = nullptr;
+    RangeKernel m_ContactKernel = nullptr;
+    RangeKernel m_IntegrateKernel = nullptr;
+    void (SimulationEngine::*m_FormBondsKernel)() = nullptr;
+    bool m_HasInactiveAgents = false;   // Fixed or ghost agents present (set by Init / domain import)
+                                        // Sleeping agents also select the SkipInactive kernels
+    
+    // --- Scheduling ---
+    bool m_UseTaskGraph = false;        // Work-stealing task graph instead of OpenMP loops
+    int m_ThreadCount = 0;              // OpenMP team and task pool size (0 = the process default), see AutoTuner.h
+    int ThreadCount() const;
+    void ApplyThreadCount();
+    // Widest neighbour search (bond formation, collision radius, contact cutoff): grid cells must be this wide
+    float RequiredCellSize() const;
+    // The graph's tasks capture 'this', so a copied engine starts without graph and pool
+    struct StepScheduling {
+        TaskGraph graph;
+        std::unique_ptr<TaskScheduler> scheduler;
+        StepScheduling() = default;
+        StepScheduling(const StepScheduling&) {}
+        StepScheduling& operator=(const StepScheduling&) { return *this; }
+    };
+    StepScheduling m_Scheduling;
+    std::vector<glm::vec3> m_SpringForces; // Per agent, added during integration
+    StepTimings m_Timings;
+    // A stream belongs to one engine: a copy starts without one
+    struct TelemetryLink {
+        std::unique_ptr<TelemetryPublisher> publisher;
+        TelemetryLink() = default;
+        TelemetryLink(const TelemetryLink&) {}
+        TelemetryLink& operator=(const TelemetryLink&) { return *this; }
+    };
+    TelemetryLink m_Telemetry;
+    std::mt19937 m_BondRng{1337};
     
     // Analytics
     int m_BrokenBondsTotal = 0;
     float GetYoungsModulus() const;
     
+    SimulationEngine(const SimulationEngine&) = default;   // Use Clone(), springs need re-pointing
+
     friend class Application;
+    friend class Rheometer;
+    friend class DomainDecomposition;
+    friend class AutoTuner;
+    friend struct GsSimulation;         // C API handle (src/Api/GlutenSim.h)
 };
\ No newline at end of file
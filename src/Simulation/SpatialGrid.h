@@ -1,5 +1,6 @@
 #pragma once
 #include "Agent.h"
+#include "PeriodicBox.h"
 #include <vector>
 #include <cmath>
 #include <algorithm>
@@ -10,6 +11,8 @@ public:
         : m_CellSize(cellSize), m_Width(width), m_Height(height), m_Depth(depth) 
     {
         m_Grid.resize(width * height * depth);
+        // Headroom so agents moving into a fresh cell do not allocate during a step
+        for (auto& cell : m_Grid) cell.reserve(CELL_RESERVE);
     }
 
     void Clear() {
@@ -25,6 +28,123 @@ public:
         }
     }
 
+    // Full rebuild, also records the cell of every agent for incremental updates
+    void Rebuild(std::vector<Agent>& agents) {
+        Clear();
+        m_AgentCell.resize(agents.size());
+        glm::ivec3 lo(m_Width, m_Height, m_Depth), hi(-1);
+        for (size_t i = 0; i < agents.size(); ++i) {
+            int index = GetCellIndex(agents[i].position);
+            m_AgentCell[i] = index;
+            if (index < 0) continue;
+            m_Grid[index].push_back(&agents[i]);
+            glm::ivec3 c(index % m_Width, (index / m_Width) % m_Height, index / (m_Width * m_Height));
+            lo = glm::min(lo, c);
+            hi = glm::max(hi, c);
+        }
+        ReserveOccupied(lo, hi);
+        m_Base = agents.data();
+        m_Count = agents.size();
+        m_Valid = true;
+        m_LastMigrations = (int)agents.size();
+    }
+
+    // Moves only the agents whose cell changed since the last call.
+    // Falls back to Rebuild when the agent array changed or too many agents migrated.
+    void Update(std::vector<Agent>& agents) {
+        if (!m_Valid || agents.data() != m_Base || agents.size() != m_Count) {
+            Rebuild(agents);
+            return;
+        }
+
+        m_Migrations.clear();
+        for (size_t i = 0; i < agents.size(); ++i) {
+            int index = GetCellIndex(agents[i].position);
+            if (index != m_AgentCell[i]) m_Migrations.push_back({ (int)i, index });
+        }
+
+        m_LastMigrations = (int)m_Migrations.size();
+        if (m_Migrations.size() > agents.size() * m_RebuildFraction) {
+            Rebuild(agents);
+            m_LastMigrations = (int)m_Migrations.size();
+            return;
+        }
+
+        for (const auto& m : m_Migrations) {
+            Agent* agent = &agents[m.agent];
+            int from = m_AgentCell[m.agent];
+            if (from >= 0) {
+                auto& cell = m_Grid[from];
+                auto it = std::find(cell.begin(), cell.end(), agent);
+                if (it != cell.end()) {
+                    *it = cell.back();
+                    cell.pop_back();
+                }
+            }
+            if (m.cell >= 0) {
+                auto& cell = m_Grid[m.cell];
+                // This push reallocates; the rebuild it requests raises the reserve of every occupied cell
+                if (cell.size() == cell.capacity()) {
+                    m_Overflowed = true;
+                    m_Valid = false;
+                }
+                cell.push_back(agent);
+            }
+            m_AgentCell[m.agent] = m.cell;
+        }
+    }
+
+    // Call when agents were added, removed or reordered without a reallocation
+    void Invalidate() { m_Valid = false; }
+
+    // New cell size over the same extent (-5..5 on every axis); the next Update rebuilds
+    void Resize(float cellSize) {
+        int cells = (int)std::ceil(10.0f / cellSize);
+        m_CellSize = cellSize;
+        m_Width = m_Height = m_Depth = cells;
+        m_Grid.assign((size_t)cells * cells * cells, {});
+        for (auto& cell : m_Grid) cell.reserve(CELL_RESERVE);
+        m_CellCapacity = CELL_RESERVE;
+        m_Valid = false;
+    }
+
+    // Periodic mode: agents are binned into the box's cells and neighbour walks wrap around it
+    // (including the Lees-Edwards offset, so the box is passed again whenever the offset moved)
+    void SetPeriodicBox(const PeriodicBox& box) {
+        if (!m_Periodic) m_Valid = false;
+        m_Box = box;
+        m_Periodic = true;
+    }
+    void ClearPeriodicBox() {
+        if (m_Periodic) m_Valid = false;
+        m_Periodic = false;
+    }
+    bool IsPeriodic() const { return m_Periodic; }
+    const PeriodicBox& GetPeriodicBox() const { return m_Box; }
+    float GetCellSize() const { return m_CellSize; }
+
+    int GetLastMigrations() const { return m_LastMigrations; }
+
+    // Cell index of agent i as of the last Update / Rebuild (-1 = outside the grid)
+    int GetAgentCell(int i) const { return m_AgentCell[i]; }
+    // Cells per axis; cell (x, y, z) has index x + y * width + z * width * height
+    glm::ivec3 GetDimensions() const { return glm::ivec3(m_Width, m_Height, m_Depth); }
+
+    // Integer cell coordinates (may lie outside the grid)
+    glm::ivec3 GetCellCoords(const glm::vec3& pos) const {
+        return glm::ivec3((int)((pos.x + 5.0f) / m_CellSize),
+                          (int)((pos.y + 5.0f) / m_CellSize),
+                          (int)((pos.z + 5.0f) / m_CellSize));
+    }
+
+    // Position along a Morton (Z-order) curve over the cells: nearby cells get nearby keys.
+    // Coordinates are clamped into the grid, 10 bits per axis.
+    unsigned int GetMortonKey(const glm::vec3& pos) const {
+        glm::ivec3 c = glm::clamp(GetCellCoords(pos), glm::ivec3(0), glm::ivec3(m_Width - 1, m_Height - 1, m_Depth - 1));
+        return SpreadBits((unsigned int)c.x) | (SpreadBits((unsigned int)c.y) << 1) | (SpreadBits((unsigned int)c.z) << 2);
+    }
+    float m_RebuildFraction = 0.1f;     // Above this share of migrating agents a full rebuild is cheaper
+
     // Returns potential neighbors (including self's cell and adjacent cells)
     void GetNeighbors(const glm::vec3& pos, std::vector<Agent*>& outNeighbors) {
         int cx = (int)((pos.x + 5.0f) / m_CellSize); // Offset to handle negative coords
@@ -45,6 +165,15 @@ public:
 
     template<typename Func>
     void ForEachNeighbor(const glm::vec3& pos, Func func) {
+        if (m_Periodic) {
+            // Callers take the minimum image of the separation, the shift is not needed here
+            m_Box.ForEachNeighborRun(pos, [&](int x0, int x1, int y, int z, const glm::vec3&) {
+                for (int x = x0; x <= x1; ++x) {
+                    for (auto* agent : m_Grid[x + y * m_Width + z * m_Width * m_Height]) func(agent);
+                }
+            });
+            return;
+        }
         int cx = (int)((pos.x + 5.0f) / m_CellSize);
         int cy = (int)((pos.y + 5.0f) / m_CellSize);
         int cz = (int)((pos.z + 5.0f) / m_CellSize);
@@ -64,14 +193,62 @@ public:
     }
 
 private:
+    static constexpr int CELL_RESERVE = 8;
     float m_CellSize;
     int m_Width, m_Height, m_Depth;
     std::vector<std::vector<Agent*>> m_Grid;
+    size_t m_CellCapacity = CELL_RESERVE;  // Reserved in every cell of the occupied box
+    bool m_Overflowed = false;              // An incremental update outgrew a cell's reserve
+
+    // Every cell in the box of occupied cells (plus one around it) gets the same reserve, doubled past the
+    // fullest cell whenever one outgrew it, so agents crowding into any of them during incremental
+    // updates do not allocate. After a few such rebuilds it covers the densest packing the run reaches.
+    void ReserveOccupied(const glm::ivec3& lo, const glm::ivec3& hi) {
+        if (hi.x < lo.x) return;
+        glm::ivec3 first = glm::max(lo - 1, glm::ivec3(0));
+        glm::ivec3 last = glm::min(hi + 1, glm::ivec3(m_Width - 1, m_Height - 1, m_Depth - 1));
+        size_t fullest = 0;
+        for (int z = first.z; z <= last.z; ++z)
+            for (int y = first.y; y <= last.y; ++y)
+                for (int x = first.x; x <= last.x; ++x) fullest = std::max(fullest, m_Grid[GetIndexFromCoords(x, y, z)].size());
+        if (m_Overflowed || fullest > m_CellCapacity) m_CellCapacity = 2 * std::max(fullest, m_CellCapacity);
+        m_Overflowed = false;
+        for (int z = first.z; z <= last.z; ++z)
+            for (int y = first.y; y <= last.y; ++y)
+                for (int x = first.x; x <= last.x; ++x) m_Grid[GetIndexFromCoords(x, y, z)].reserve(m_CellCapacity);
+    }
+
+    // Incremental mode
+    struct Migration { int agent; int cell; };
+    std::vector<int> m_AgentCell;       // Current cell per agent index (-1 = outside the grid)
+    std::vector<Migration> m_Migrations;
+    const Agent* m_Base = nullptr;
+    size_t m_Count = 0;
+    bool m_Valid = false;
+    int m_LastMigrations = 0;
+
+    bool m_Periodic = false;
+    PeriodicBox m_Box;
+
+    // Inserts two zero bits between each of the low 10 bits
+    static unsigned int SpreadBits(unsigned int v) {
+        v &= 0x3ff;
+        v = (v | (v << 16)) & 0x030000ff;
+        v = (v | (v << 8)) & 0x0300f00f;
+        v = (v | (v << 4)) & 0x030c30c3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    }
 
     int GetCellIndex(const glm::vec3& pos) {
         int x = (int)((pos.x + 5.0f) / m_CellSize);
         int y = (int)((pos.y + 5.0f) / m_CellSize);
         int z = (int)((pos.z + 5.0f) / m_CellSize);
+        if (m_Periodic) {
+            // Wrapped positions may round onto the far face of the box
+            glm::ivec3 c = glm::clamp(glm::ivec3(x, y, z), m_Box.firstCell, m_Box.firstCell + m_Box.cells - 1);
+            x = c.x; y = c.y; z = c.z;
+        }
         return GetIndexFromCoords(x, y, z);
     }
 
@@ -0,0 +1,123 @@
+#include "TaskGraph.h"
+#include <algorithm>
+
+int TaskGraph::Add(std::function<void()> fn) {
+    m_Nodes.push_back(std::make_unique<Node>());
+    m_Nodes.back()->fn = std::move(fn);
+    return (int)m_Nodes.size() - 1;
+}
+
+void TaskGraph::Precede(int before, int after) {
+    m_Nodes[before]->successors.push_back(m_Nodes[after].get());
+    m_Nodes[after]->dependencyCount++;
+}
+
+TaskScheduler::TaskScheduler(int threadCount) {
+    if (threadCount <= 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 0; i < threadCount; ++i) {
+        m_Queues.push_back(std::make_unique<Queue>());
+    }
+    // Queue 0 belongs to the thread calling Run()
+    for (int i = 1; i < threadCount; ++i) {
+        m_Threads.emplace_back(&TaskScheduler::WorkerLoop, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Quit = true;
+    }
+    m_Wake.notify_all();
+    for (auto& t : m_Threads) t.join();
+}
+
+void TaskScheduler::Run(TaskGraph& graph) {
+    if (graph.m_Nodes.empty()) return;
+
+    for (auto& node : graph.m_Nodes) {
+        node->pending.store(node->dependencyCount, std::memory_order_relaxed);
+    }
+    m_Remaining.store((int)graph.m_Nodes.size());
+
+    // Spread the roots so every thread has something to start with
+    int next = 0;
+    for (auto& node : graph.m_Nodes) {
+        if (node->dependencyCount == 0) {
+            Push(next, node.get());
+            next = (next + 1) % (int)m_Queues.size();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Generation++;
+    }
+    m_Wake.notify_all();
+
+    while (m_Remaining.load() > 0) {
+        if (!RunOne(0)) std::this_thread::yield();
+    }
+}
+
+void TaskScheduler::WorkerLoop(int index) {
+    unsigned seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_WakeMutex);
+            m_Wake.wait(lock, [&]() { return m_Quit || m_Generation != seen; });
+            if (m_Quit) return;
+            seen = m_Generation;
+        }
+        while (m_Remaining.load() > 0) {
+            if (!RunOne(index)) std::this_thread::yield();
+        }
+    }
+}
+
+bool TaskScheduler::RunOne(int index) {
+    TaskGraph::Node* task = nullptr;
+    {
+        Queue& own = *m_Queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.tasks.size() > own.head) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+        }
+        if (own.tasks.size() == own.head) {
+            own.tasks.clear();
+            own.head = 0;
+        }
+    }
+
+    // Steal the oldest task of another thread
+    int count = (int)m_Queues.size();
+    for (int i = 1; !task && i < count; ++i) {
+        Queue& victim = *m_Queues[(index + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.size() > victim.head) {
+            task = victim.tasks[victim.head++];
+            if (victim.tasks.size() == victim.head) {
+                victim.tasks.clear();
+                victim.head = 0;
+            }
+        }
+    }
+    if (!task) return false;
+
+    task->fn();
+
+    // Released successors stay on this thread (their inputs are in our cache)
+    for (auto* next : task->successors) {
+        if (next->pending.fetch_sub(1) == 1) Push(index, next);
+    }
+    m_Remaining.fetch_sub(1);
+    return true;
+}
+
+void TaskScheduler::Push(int index, TaskGraph::Node* node) {
+    Queue& queue = *m_Queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(node);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Static dependency graph of tasks, built once and re-run every step.
+class TaskGraph {
+public:
+    int Add(std::function<void()> fn);
+    void Precede(int before, int after);    // 'after' waits for 'before'
+    bool Empty() const { return m_Nodes.empty(); }
+    void Clear() { m_Nodes.clear(); }
+
+private:
+    struct Node {
+        std::function<void()> fn;
+        std::vector<Node*> successors;
+        int dependencyCount = 0;
+        std::atomic<int> pending{0};
+    };
+    std::vector<std::unique_ptr<Node>> m_Nodes;
+
+    friend class TaskScheduler;
+};
+
+// Persistent thread pool running a TaskGraph with per-thread deques and work stealing.
+// The owner pops from the back of its deque (newest, cache-warm), thieves take from the front.
+class TaskScheduler {
+public:
+    explicit TaskScheduler(int threadCount = 0); // 0 = hardware concurrency
+    ~TaskScheduler();
+
+    // Blocks until every task has run; the calling thread works as queue 0
+    void Run(TaskGraph& graph);
+    int GetThreadCount() const { return (int)m_Queues.size(); }
+
+private:
+    // Vector + head index instead of a deque: keeps its capacity between runs, so no allocations per step
+    struct Queue {
+        std::mutex mutex;
+        std::vector<TaskGraph::Node*> tasks;
+        size_t head = 0;    // Tasks before head were stolen
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_Queues;
+    std::vector<std::thread> m_Threads;
+    std::atomic<int> m_Remaining{0};
+
+    std::mutex m_WakeMutex;
+    std::condition_variable m_Wake;
+    unsigned m_Generation = 0;
+    bool m_Quit = false;
+
+    void WorkerLoop(int index);
+    bool RunOne(int index);
+    void Push(int index, TaskGraph::Node* node);
+};
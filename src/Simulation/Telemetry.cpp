@@ -0,0 +1,230 @@
+#include "Telemetry.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+    const uint32_t TELEMETRY_MAGIC = 0x47534d54; // "GSMT"
+    const uint32_t TELEMETRY_VERSION = 1;
+    const char* const SEGMENT_PREFIX = "glutensim-";
+
+    std::string SegmentName(const char* stream) {
+        return std::string("/") + SEGMENT_PREFIX + stream;
+    }
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+struct TelemetryPublisher::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t capacity;
+    std::atomic<uint64_t> published;    // Records written so far; record i lives in slot i % capacity
+    std::atomic<uint32_t> closed;
+};
+
+namespace {
+    // Every slot: sequence word followed by the record. seq = 2i+1 while record i is written, 2i+2 when done.
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        TelemetryRecord record;
+    };
+
+    size_t HeaderBytes() { return 64; }
+
+    Slot* SlotAt(TelemetryPublisher::Header* header, uint64_t index) {
+        return (Slot*)((char*)header + HeaderBytes()) + index % header->capacity;
+    }
+
+    static_assert(sizeof(TelemetryPublisher::Header) <= 64, "Header must fit in front of the slots");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared-memory atomics must be lock-free");
+}
+
+#ifdef _WIN32
+
+bool TelemetryPublisher::Open(const char*, int) {
+    std::cerr << "Telemetry is only available on POSIX systems" << std::endl;
+    return false;
+}
+void TelemetryPublisher::Close() {}
+void TelemetryPublisher::Publish(TelemetryRecord) {}
+
+bool TelemetryReader::Open(const char*) { return false; }
+void TelemetryReader::Close() {}
+void TelemetryReader::Poll(std::vector<TelemetryRecord>&) {}
+bool TelemetryReader::Latest(TelemetryRecord&) const { return false; }
+bool TelemetryReader::IsClosed() const { return true; }
+bool TelemetryReader::ReadSlot(uint64_t, TelemetryRecord&) const { return false; }
+std::vector<std::string> TelemetryReader::ListStreams() { return {}; }
+bool TelemetryReader::Remove(const char*) { return false; }
+
+#else
+
+bool TelemetryPublisher::Open(const char* stream, int capacity) {
+    Close();
+    capacity = capacity > 0 ? capacity : 1;
+    m_Name = SegmentName(stream);
+    m_MappedSize = HeaderBytes() + (size_t)capacity * sizeof(Slot);
+
+    int fd = shm_open(m_Name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)m_MappedSize) != 0) {
+        std::cerr << "Failed to create telemetry stream " << m_Name << std::endl;
+        if (fd >= 0) { close(fd); shm_unlink(m_Name.c_str()); }
+        return false;
+    }
+    void* mem = mmap(nullptr, m_MappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        std::cerr << "Failed to map telemetry stream " << m_Name << std::endl;
+        shm_unlink(m_Name.c_str());
+        return false;
+    }
+
+    // ftruncate zero-fills: every slot starts at seq 0 (empty)
+    m_Header = (Header*)mem;
+    m_Header->recordSize = sizeof(TelemetryRecord);
+    m_Header->capacity = (uint32_t)capacity;
+    m_Header->published.store(0, std::memory_order_relaxed);
+    m_Header->closed.store(0, std::memory_order_relaxed);
+    m_Header->version = TELEMETRY_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    m_Header->magic = TELEMETRY_MAGIC;     // Readers check this last
+
+    m_OpenTime = m_LastWallTime = Now();
+    m_StepsPerSecond = 0.0f;
+    return true;
+}
+
+void TelemetryPublisher::Close() {
+    if (!m_Header) return;
+    // The segment stays for readers that want the tail of the run; TelemetryReader::Remove deletes it
+    m_Header->closed.store(1, std::memory_order_release);
+    munmap(m_Header, m_MappedSize);
+    m_Header = nullptr;
+}
+
+void TelemetryPublisher::Publish(TelemetryRecord record) {
+    if (!m_Header) return;
+
+    double now = Now();
+    double elapsed = now - m_LastWallTime;
+    m_LastWallTime = now;
+    if (elapsed > 0.0) {
+        float rate = (float)(1.0 / elapsed);
+        m_StepsPerSecond = m_StepsPerSecond > 0.0f ? 0.95f * m_StepsPerSecond + 0.05f * rate : rate;
+    }
+
+    uint64_t index = m_Header->published.load(std::memory_order_relaxed);
+    record.step = index;
+    record.wallTime = now - m_OpenTime;
+    record.stepsPerSecond = m_StepsPerSecond;
+
+    Slot* slot = SlotAt(m_Header, index);
+    slot->seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);  // Odd sequence is visible before the data changes
+    slot->record = record;
+    slot->seq.store(2 * index + 2, std::memory_order_release);
+    m_Header->published.store(index + 1, std::memory_order_release);
+}
+
+bool TelemetryReader::Open(const char* stream) {
+    Close();
+    std::string name = SegmentName(stream);
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < HeaderBytes()) {
+        close(fd);
+        return false;
+    }
+    void* mem = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) return false;
+
+    auto* header = (TelemetryPublisher::Header*)mem;
+    bool valid = header->magic == TELEMETRY_MAGIC && header->version == TELEMETRY_VERSION &&
+                 header->recordSize == sizeof(TelemetryRecord) &&
+                 HeaderBytes() + (size_t)header->capacity * sizeof(Slot) <= (size_t)st.st_size;
+    if (!valid) {
+        munmap(mem, (size_t)st.st_size);
+        return false;
+    }
+
+    m_Header = header;
+    m_MappedSize = (size_t)st.st_size;
+    m_Next = 0;
+    m_Dropped = 0;
+    return true;
+}
+
+void TelemetryReader::Close() {
+    if (!m_Header) return;
+    munmap(m_Header, m_MappedSize);
+    m_Header = nullptr;
+}
+
+bool TelemetryReader::ReadSlot(uint64_t index, TelemetryRecord& out) const {
+    // Seqlock read: the copy only counts if the sequence was the finished value before and after it
+    const Slot* slot = SlotAt(m_Header, index);
+    uint64_t before = slot->seq.load(std::memory_order_acquire);
+    if (before != 2 * index + 2) return false;
+    std::memcpy(&out, (const void*)&slot->record, sizeof(TelemetryRecord));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot->seq.load(std::memory_order_relaxed) == before;
+}
+
+void TelemetryReader::Poll(std::vector<TelemetryRecord>& out) {
+    if (!m_Header) return;
+    uint64_t published = m_Header->published.load(std::memory_order_acquire);
+    uint64_t capacity = m_Header->capacity;
+    if (published > capacity && m_Next < published - capacity) {
+        m_Dropped += published - capacity - m_Next;
+        m_Next = published - capacity;
+    }
+
+    TelemetryRecord record;
+    for (; m_Next < published; ++m_Next) {
+        if (ReadSlot(m_Next, record)) out.push_back(record);
+        else m_Dropped++;   // Overwritten while we were reading it
+    }
+}
+
+bool TelemetryReader::Latest(TelemetryRecord& out) const {
+    if (!m_Header) return false;
+    uint64_t published = m_Header->published.load(std::memory_order_acquire);
+    return published > 0 && ReadSlot(published - 1, out);
+}
+
+bool TelemetryReader::IsClosed() const {
+    return !m_Header || m_Header->closed.load(std::memory_order_acquire) != 0;
+}
+
+std::vector<std::string> TelemetryReader::ListStreams() {
+    std::vector<std::string> streams;
+    DIR* dir = opendir("/dev/shm");
+    if (!dir) return streams;
+    size_t prefix = std::strlen(SEGMENT_PREFIX);
+    while (dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, SEGMENT_PREFIX, prefix) == 0) streams.push_back(entry->d_name + prefix);
+    }
+    closedir(dir);
+    return streams;
+}
+
+bool TelemetryReader::Remove(const char* stream) {
+    return shm_unlink(SegmentName(stream).c_str()) == 0;
+}
+
+#endif
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-step telemetry in a POSIX shared-memory ring, for monitoring headless runs from other processes.
+//
+// One publisher (the simulation) appends fixed-size records; any number of readers poll the ring
+// without locks. Each record carries a sequence word that is odd while it is being written, so a
+// reader that raced the writer simply retries or skips that record. Segments are named
+// /glutensim-<stream> and stay in /dev/shm after the run until a reader removes them.
+
+enum StepPhase {
+    PHASE_MAINTENANCE,  // Population changes, spatial sort, proofing field
+    PHASE_GROW,
+    PHASE_EXTERNAL,
+    PHASE_GRID,
+    PHASE_BONDS,
+    PHASE_CONTACTS,     // Mixer update and contact forces
+    PHASE_SPRINGS,
+    PHASE_INTEGRATE,
+    PHASE_TOTAL,
+    PHASE_COUNT
+};
+
+inline const char* const PHASE_NAMES[PHASE_COUNT] = {
+    "maintenance", "grow", "external", "grid", "bonds", "contacts", "springs", "integrate", "total",
+};
+
+// Wall-clock milliseconds of the last step per phase. The task graph overlaps the phases,
+// so there only maintenance and total are filled in.
+struct StepTimings {
+    float ms[PHASE_COUNT] = {};
+};
+
+struct TelemetryRecord {
+    uint64_t step;
+    double simTime;
+    double wallTime;            // Seconds since the stream was opened
+    int32_t agents;
+    int32_t bonds;
+    int32_t brokenBonds;        // Cumulative
+    float youngsModulus;
+    float stepsPerSecond;       // Smoothed over the last steps
+    float phaseMs[PHASE_COUNT];
+};
+
+class TelemetryPublisher {
+public:
+    ~TelemetryPublisher() { Close(); }
+
+    // Creates (or replaces) /glutensim-<stream> with room for 'capacity' records
+    bool Open(const char* stream, int capacity = 4096);
+    void Close();
+    bool IsOpen() const { return m_Header != nullptr; }
+
+    // Fills in step, wall time and steps/sec, then appends. Never blocks or allocates.
+    void Publish(TelemetryRecord record);
+
+    struct Header;              // Shared layout, defined in the .cpp
+
+private:
+    Header* m_Header = nullptr;
+    size_t m_MappedSize = 0;
+    std::string m_Name;
+    double m_OpenTime = 0.0;
+    double m_LastWallTime = 0.0;
+    float m_StepsPerSecond = 0.0f;
+};
+
+class TelemetryReader {
+public:
+    ~TelemetryReader() { Close(); }
+
+    bool Open(const char* stream);
+    void Close();
+    bool IsOpen() const { return m_Header != nullptr; }
+
+    // Appends the records published since the last call (oldest first). If the reader fell more than
+    // a ring behind, the overwritten records are skipped and counted in GetDropped().
+    void Poll(std::vector<TelemetryRecord>& out);
+    // Most recent complete record; false while the stream is empty
+    bool Latest(TelemetryRecord& out) const;
+    bool IsClosed() const;      // The publisher has closed the stream (the run ended)
+    uint64_t GetDropped() const { return m_Dropped; }
+
+    // Stream names currently present in shared memory
+    static std::vector<std::string> ListStreams();
+    static bool Remove(const char* stream);
+
+private:
+    TelemetryPublisher::Header* m_Header = nullptr;
+    size_t m_MappedSize = 0;
+    uint64_t m_Next = 0;
+    uint64_t m_Dropped = 0;
+
+    bool ReadSlot(uint64_t index, TelemetryRecord& out) const;
+};
@@ -0,0 +1,62 @@
+// Generational agent handles (src/Simulation/AgentPool.h): a handle names one agent until it is
+// removed, and never resolves to a different agent afterwards
+#include "Check.h"
+#include "Simulation/SimulationEngine.h"
+
+namespace {
+    const float DT = 0.01f;
+    const glm::vec3 INSIDE_BOWL(0.3f, -0.5f, 0.0f);
+
+    // A respawn renumbers the agents from 0, so every slot is reused by an unrelated agent
+    void HandlesGoStaleOnInit() {
+        SimulationEngine engine;
+        engine.Init(100);
+        AgentHandle first = engine.GetHandle(5);
+        AgentHandle last = engine.GetHandle(99);
+        CHECK(engine.Resolve(first) != nullptr);
+        CHECK(engine.Resolve(last) != nullptr);
+
+        engine.Init(100);
+        CHECK(engine.Resolve(first) == nullptr);
+        CHECK(engine.Resolve(last) == nullptr);
+
+        // Fewer agents, then slots past the old count handed out again by insertions
+        engine.Init(50);
+        CHECK(engine.Resolve(last) == nullptr);
+        AgentHandle fresh = engine.GetHandle(5);
+        CHECK(fresh != first);
+        for (int i = 0; i < 60; ++i) engine.QueueInsert(GLUTENIN, INSIDE_BOWL);
+        engine.Update(DT);
+        CHECK(engine.Resolve(last) == nullptr);
+        CHECK(engine.Resolve(fresh) != nullptr);
+    }
+
+    void RemovingPendingInsertCancelsIt() {
+        SimulationEngine engine;
+        engine.Init(100);
+        size_t count = engine.GetAgents().size();
+
+        AgentHandle cancelled = engine.QueueInsert(STARCH, INSIDE_BOWL);
+        AgentHandle kept = engine.QueueInsert(GLIADIN, INSIDE_BOWL);
+        engine.QueueRemove(cancelled);
+        engine.Update(DT);
+
+        CHECK(engine.GetAgents().size() == count + 1);
+        CHECK(engine.Resolve(cancelled) == nullptr);
+        const Agent* agent = engine.Resolve(kept);
+        CHECK(agent != nullptr && agent->type == GLIADIN);
+
+        // The freed slot comes back with a new generation, the cancelled handle stays stale
+        AgentHandle reused = engine.QueueInsert(STARCH, INSIDE_BOWL);
+        CHECK(reused.slot == cancelled.slot && reused != cancelled);
+        engine.Update(DT);
+        CHECK(engine.Resolve(reused) != nullptr);
+        CHECK(engine.Resolve(cancelled) == nullptr);
+    }
+}
+
+int main() {
+    HandlesGoStaleOnInit();
+    RemovingPendingInsertCancelsIt();
+    return TestResult();
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdio>
+
+// Minimal checks for the test executables (see tests/CMakeLists.txt): a failed CHECK is reported and
+// counted, and main() returns TestResult()
+namespace Check {
+    inline int& Failures() {
+        static int failures = 0;
+        return failures;
+    }
+}
+
+#define CHECK(condition)                                                                          \
+    do {                                                                                          \
+        if (!(condition)) {                                                                       \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);    \
+            Check::Failures()++;                                                                  \
+        }                                                                                         \
+    } while (0)
+
+inline int TestResult() {
+    return Check::Failures() == 0 ? 0 : 1;
+}
+
+// ctest reports a test that returns this as skipped (SKIP_RETURN_CODE)
+const int TEST_SKIPPED = 77;
@@ -0,0 +1,34 @@
+// A warm simulation step must not touch the heap, on the stepping thread or in its OpenMP team; the
+// Performance panel counts frame allocations the same way (src/Core/AllocationTracker.h)
+#include "Check.h"
+#include "Core/AllocationTracker.h"
+#include "Simulation/SimulationEngine.h"
+
+namespace {
+    const int AGENTS = 2000;
+    const int WARMUP_STEPS = 300;       // Buffers, grid cells and bond lists reach their working size
+    const int MEASURED_STEPS = 200;
+    const float DT = 0.01f;
+
+    size_t StepAllocations(SimulationEngine& engine, int steps) {
+        size_t start = AllocationTracker::GetAllocationCount();
+        for (int i = 0; i < steps; ++i) engine.Update(DT);
+        return AllocationTracker::GetAllocationCount() - start;
+    }
+}
+
+int main() {
+    if (!AllocationTracker::IsEnabled()) {
+        std::printf("Allocation tracking is compiled out (NDEBUG), skipping\n");
+        return TEST_SKIPPED;
+    }
+
+    SimulationEngine engine;
+    engine.Init(AGENTS);
+    StepAllocations(engine, WARMUP_STEPS);
+
+    size_t allocations = StepAllocations(engine, MEASURED_STEPS);
+    if (allocations > 0) std::fprintf(stderr, "%zu heap allocations in %d warm steps\n", allocations, MEASURED_STEPS);
+    CHECK(allocations == 0);
+    return TestResult();
+}
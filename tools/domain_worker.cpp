@@ -0,0 +1,15 @@
+// Worker process of the multi-process mode (src/Simulation/DomainDecomposition.h), spawned by the
+// coordinator, never started by hand.
+//
+//   glutensim-worker <shared memory name> <slab index>
+#include "Simulation/DomainDecomposition.h"
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <shared memory name> <slab index>\n", argv[0]);
+        return 2;
+    }
+    return DomainDecomposition::RunWorker(argv[1], std::atoi(argv[2]));
+}
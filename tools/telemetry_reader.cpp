@@ -0,0 +1,88 @@
+// Reader for the simulation's shared-memory telemetry streams (src/Simulation/Telemetry.h).
+//
+//   glutensim-telemetry                      latest record of every stream on this node
+//   glutensim-telemetry --watch              the same, refreshed every second
+//   glutensim-telemetry <stream> [every]     follow one stream as CSV (every n-th step) until it closes
+//   glutensim-telemetry --remove <stream>    delete a finished stream
+#include "Simulation/Telemetry.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+    void PrintTable() {
+        std::printf("%-24s %10s %9s %7s %7s %8s %10s %9s %9s  %s\n",
+                    "stream", "step", "time(s)", "agents", "bonds", "broken", "modulus", "steps/s", "step(ms)", "state");
+        for (const std::string& stream : TelemetryReader::ListStreams()) {
+            TelemetryReader reader;
+            TelemetryRecord r;
+            if (!reader.Open(stream.c_str())) {
+                std::printf("%-24s (unreadable or other version)\n", stream.c_str());
+                continue;
+            }
+            if (!reader.Latest(r)) {
+                std::printf("%-24s (no records yet)\n", stream.c_str());
+                continue;
+            }
+            std::printf("%-24s %10llu %9.2f %7d %7d %8d %10.2f %9.1f %9.3f  %s\n", stream.c_str(),
+                        (unsigned long long)r.step, r.simTime, r.agents, r.bonds, r.brokenBonds, r.youngsModulus,
+                        r.stepsPerSecond, r.phaseMs[PHASE_TOTAL], reader.IsClosed() ? "closed" : "running");
+        }
+    }
+
+    int Follow(const char* stream, int every) {
+        TelemetryReader reader;
+        if (!reader.Open(stream)) {
+            std::fprintf(stderr, "No telemetry stream '%s'\n", stream);
+            return 1;
+        }
+
+        std::printf("step,sim_time,wall_time,agents,bonds,broken,modulus,steps_per_s");
+        for (int p = 0; p < PHASE_COUNT; ++p) std::printf(",%s_ms", PHASE_NAMES[p]);
+        std::printf("\n");
+
+        std::vector<TelemetryRecord> records;
+        while (true) {
+            // Read the closed flag first so the records published before closing are still printed
+            bool closed = reader.IsClosed();
+            records.clear();
+            reader.Poll(records);
+            for (const TelemetryRecord& r : records) {
+                if (r.step % every != 0) continue;
+                std::printf("%llu,%.4f,%.4f,%d,%d,%d,%.4f,%.2f", (unsigned long long)r.step, r.simTime, r.wallTime,
+                            r.agents, r.bonds, r.brokenBonds, r.youngsModulus, r.stepsPerSecond);
+                for (int p = 0; p < PHASE_COUNT; ++p) std::printf(",%.4f", r.phaseMs[p]);
+                std::printf("\n");
+            }
+            std::fflush(stdout);
+            if (closed) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        if (reader.GetDropped() > 0) std::fprintf(stderr, "%llu records were overwritten before they were read\n",
+                                                  (unsigned long long)reader.GetDropped());
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && std::strcmp(argv[1], "--remove") == 0) {
+        if (TelemetryReader::Remove(argv[2])) return 0;
+        std::fprintf(stderr, "No telemetry stream '%s'\n", argv[2]);
+        return 1;
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "--watch") == 0) {
+        while (true) {
+            std::printf("\033[H\033[2J");
+            PrintTable();
+            std::fflush(stdout);
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+    if (argc >= 2) return Follow(argv[1], argc >= 3 ? std::max(1, std::atoi(argv[2])) : 1);
+
+    PrintTable();
+    return 0;
+}